@@ -124,6 +124,71 @@ static inline uint32 MeshesIds[] = {
 
 /* ------------------------------  */
 
+static inline constexpr uint32 AssetNameSeeds[] = {
+	13, 7, 3, 18, 7, 49, 44, 514,
+	6, 16, 284, 42, 863,
+};
+
+static inline constexpr AssetName AssetNames[] = {
+	{ "I_EVIL_SHIP_3", 3, 4 },
+	{ "MAT_PHONG0_CB", 32771, 3 },
+	{ "T_ATLAS_1", 32770, 0 },
+	{ "T_CHECKER", 32775, 0 },
+	{ "A_SHOOT", 20, 6 },
+	{ "T_ATLAS_0", 32769, 0 },
+	{ "MAT_TEX0_BaseMap", 32785, 0 },
+	{ "T_ROCKS_COLOR", 32776, 0 },
+	{ "M_SUZANNE", 17, 8 },
+	{ "A_EXPLODE", 21, 6 },
+	{ "MAT_PHONG1_CB", 32772, 3 },
+	{ "SimpleColor_CB", 32770, 3 },
+	{ "I_HEART", 8, 4 },
+	{ "M_TREE_1_IB", 32769, 2 },
+	{ "I_SHOOT", 11, 4 },
+	{ "T_STONES_AO", 32784, 0 },
+	{ "T_STONES_COLOR", 32780, 0 },
+	{ "SimpleColor", 16, 9 },
+	{ "T_ATLAS_2", 32771, 0 },
+	{ "MAT_PHONG1", 23, 9 },
+	{ "MAT_TEX0_AoMap", 32786, 0 },
+	{ "Material_001_CB", 32769, 3 },
+	{ "MAT_TEX0_CB", 32773, 3 },
+	{ "Material_001", 14, 9 },
+	{ "M_SUZANNE_VB", 32770, 1 },
+	{ "T_NIGHT_SKY", 32774, 0 },
+	{ "I_EVIL_SHIP_1", 1, 4 },
+	{ "MAT_TEX0", 24, 9 },
+	{ "F_DroidSansBold_24", 19, 5 },
+	{ "T_STONES_DISPLACEMENT", 32783, 0 },
+	{ "Material_001_Kd_Map", 32772, 0 },
+	{ "T_SKY", 32773, 0 },
+	{ "I_EXPLOSION", 10, 4 },
+	{ "T_ROCKS_AO", 32778, 0 },
+	{ "I_MAIN_SHIP", 4, 4 },
+	{ "MAT_PHONG0", 22, 9 },
+	{ "M_TREE_1", 15, 8 },
+	{ "M_TREE_1_VB", 32769, 1 },
+	{ "T_STONES_ROUGHNESS", 32781, 0 },
+	{ "I_BG", 6, 4 },
+	{ "I_INSTAGRAM", 13, 4 },
+	{ "T_ROCKS_NORMAL", 32779, 0 },
+	{ "I_FACEBOOK", 12, 4 },
+	{ "T_STONES_NORMAL", 32782, 0 },
+	{ "T_FLOOR_COLOR", 32777, 0 },
+	{ "I_HEALTH", 5, 4 },
+	{ "I_BULLET", 9, 4 },
+	{ "M_SUZANNE_IB", 32770, 2 },
+	{ "I_EVIL_SHIP_2", 2, 4 },
+	{ "I_STATS", 7, 4 },
+	{ "F_DroidSans_24", 18, 5 },
+};
+
+// @Note: Dense slot of the asset in AssetNames or -1 if there is no such asset
+constexpr int32 AssetSlot(std::string_view t_Name) { return FindAssetSlot(AssetNameSeeds, AssetNames, t_Name); }
+constexpr uint32 AssetIdOf(std::string_view t_Name) { int32 slot = AssetSlot(t_Name); return slot < 0 ? 0 : AssetNames[slot].Id; }
+
+/* ------------------------------  */
+
 GPUResource GPUResources[] = {
 	{ GPUResourceType(0), 32769, "T_ATLAS_0" },
 	{ GPUResourceType(0), 32770, "T_ATLAS_1" },
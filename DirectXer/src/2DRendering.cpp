@@ -12,7 +12,7 @@ void Renderer2D::InitRenderer(Graphics* t_Graphics, Init2DParams t_Params)
 {
 	Graph = t_Graphics;
 	Params = t_Params;
-	CurrentTextureSlot = 0;
+	TexSlots.clear();
 
 	ImageLib.Init(t_Graphics);
 	FontLib.Init(t_Graphics);
@@ -40,11 +40,7 @@ void Renderer2D::BeginScene(TopolgyType sceneTopology)
 
 	Vertices.resize(TotalVertices);
 
-	CurrentTextureSlot = 0;
-	for (size_t i = 0; i < MaxTextureSlots; ++i)
-	{
-		TexSlots[i] = {0};
-	}
+	TexSlots.clear();
 
 	CurrentVertex = &Vertices[0];
 
@@ -67,7 +63,7 @@ void Renderer2D::EndScene()
 
 	Graph->SetBlendingState(BS_AlphaBlending);
 
-	for (uint32 i = 0; i < CurrentTextureSlot; ++i)
+	for (uint32 i = 0; i < TexSlots.size(); ++i)
 	{
 		Graph->BindTexture(i, TexSlots[i]);
 	}
@@ -77,19 +73,19 @@ void Renderer2D::EndScene()
 
 uint8 Renderer2D::AttachTexture(TextureId t_Tex)
 {
-	for (uint8 i = 0; i < MaxTextureSlots; ++i)
+	for (uint8 i = 0; i < TexSlots.size(); ++i)
 	{
 		if(TexSlots[i] == t_Tex) return i;
 	}
 			
-	if (CurrentTextureSlot >= MaxTextureSlots)
+	if (TexSlots.full())
 	{
 		EndScene();
 		BeginScene(SceneTopology);
 	}
-	TexSlots[CurrentTextureSlot++] = t_Tex;
+	TexSlots.push_back(t_Tex);
 
-	return CurrentTextureSlot - 1;
+	return uint8(TexSlots.size() - 1);
 }
 	
 void Renderer2D::DrawQuad(float2 pos, float2 size, float4 color)
@@ -286,7 +282,7 @@ void Renderer2D::DrawImage(uint32 t_Id, float2 pos, float2 size)
 		BeginScene(SceneTopology);
 	}
 		
-	const auto& screenImage = ImageLib.Images[t_Id];
+	const auto& screenImage = ImageLib.Images.at(t_Id);
 
 	auto slot = AttachTexture(screenImage.TexHandle);
 	uint32 type = (slot << 8) | (3 << 0);
@@ -331,11 +327,12 @@ void Renderer2D::DrawText(String text, float2 pos, FontId typeface, float4 color
 		BeginScene(SceneTopology);
 	}
 
-	Memory::EstablishTempScope(Kilobytes(5));
-	Defer { Memory::EndTempScope(); };
-	TempVector<FontLibrary::AtlasEntry> entries;
-
-	FontLib.GetEntries(typeface, text.data(), text.size(), entries);
+	// @Note: Almost all of the texts are short enough to not need any
+	// memory; the long ones spill into the frame memory as the text is
+	// drawn on the main thread
+	SmallVector<FontLibrary::AtlasEntry, 64, FrameStdAllocator<FontLibrary::AtlasEntry>> entries;
+	entries.resize(text.size());
+	FontLib.GetEntries(typeface, text.data(), text.size(), entries.data());
 		
 	float2 currentPen{0.0f, 0.0f};
 	for (const auto& entry : entries)
@@ -393,7 +390,7 @@ void Renderer2D::DrawSubImage(uint32 t_Id, float2 pos, float2 size, float2 subPo
 		BeginScene(SceneTopology);
 	}
 		
-	const auto& screenImage = ImageLib.Images[t_Id];
+	const auto& screenImage = ImageLib.Images.at(t_Id);
 
 	auto slot = AttachTexture(screenImage.TexHandle);
 	uint32 type = (slot << 8) | (3 << 0);
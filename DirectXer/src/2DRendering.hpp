@@ -78,8 +78,7 @@ class Renderer2D
     Vertex2D* CurrentVertex;
     uint32 CurrentVertexCount;
 
-    TextureId TexSlots[MaxTextureSlots];
-    uint8 CurrentTextureSlot;
+    StaticVector<TextureId, MaxTextureSlots> TexSlots;
 
 	TopolgyType SceneTopology;
 
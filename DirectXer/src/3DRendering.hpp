@@ -4,6 +4,7 @@
 #include <Memory.hpp>
 #include <Graphics.hpp>
 #include <Containers.hpp>
+#include <ConcurrentMap.hpp>
 #include <Materials.hpp>
 #include <Lighting.hpp>
 
@@ -41,7 +42,7 @@ struct Mesh
 
 struct MeshCatalog
 {
-	Map<MeshId, Mesh, Memory_3DRendering> Meshes;
+	ConcurrentMap<MeshId, Mesh, Memory_3DRendering> Meshes;
 	MaterialLibrary Materials;
 };
 
@@ -42,6 +42,8 @@ void App::Update(float dt)
 {
 	OPTICK_FRAME("MainThread");
 
+	Memory::FlipFrameMemory();
+
 	TempFormater formater;
 	
 	if (ImGui::CollapsingHeader("Telemetry"))
@@ -69,7 +71,14 @@ void App::Update(float dt)
 			String text{formater.Format("Total Temorary Memory: {:.3f} MBs", Memory::g_Memory.TempMemoryMaxSize / (1024.0f*1024.0f))};
 			ImGui::Text(text.data());
 
-			text = formater.Format("Total Bulk Memory: {:.3f} MBs", Memory::g_Memory.BulkMemoryMaxSize / (1024.0f*1024.0f));
+			text = formater.Format("Total Bulk Memory: {:.3f} MBs", Memory::g_Memory.Bulk.MaxSize / (1024.0f*1024.0f));
+			ImGui::Text(text.data());
+
+			text = formater.Format("Committed Memory: {:.3f} MBs of {:.3f} MBs reserved{}", Telemetry::CommittedMemory.load() / (1024.0f*1024.0f),
+								   Telemetry::ReservedMemory / (1024.0f*1024.0f), Memory::g_Memory.HugePages ? " (huge pages)" : "");
+			ImGui::Text(text.data());
+
+			text = formater.Format("Frame Memory: {:.2f} KBs last frame, {:.2f} KBs peak", Telemetry::LastFrameMemory / 1024.0f, Telemetry::PeakFrameMemory / 1024.0f);
 			ImGui::Text(text.data());
 				
 			ImGui::Separator();
@@ -91,6 +100,42 @@ void App::Update(float dt)
 			displayMemory(Memory_2DRendering);
 			displayMemory(Memory_3DRendering);
 			displayMemory(Memory_GPUResource);
+			displayMemory(Memory_Strings);
+			displayMemory(Memory_Jobs);
+
+			for (uint32 tag = 0; tag < Tags_Count; ++tag)
+			{
+				auto& budget = Memory::g_Memory.Budgets[tag];
+				if (!budget.Region.Memory) continue;
+
+				text = formater.Format("[{}] budget: {:.3f} MBs of {:.3f} MBs", gSystemTagNames[tag],
+									   budget.Region.Size / (1024.0f*1024.0f), budget.Region.MaxSize / (1024.0f*1024.0f));
+				ImGui::BulletText(text.data());
+			}
+
+			ImGui::Separator();
+			ImGui::Text("Heap");
+
+			auto& heap = Memory::g_Heap;
+			text = formater.Format("Pools: {} ({:.3f} MBs)", heap.PoolsCount, heap.PoolsSize / (1024.0f*1024.0f));
+			ImGui::BulletText(text.data());
+
+			text = formater.Format("Free: {:.3f} MBs, largest block: {:.3f} MBs", heap.FreeSize / (1024.0f*1024.0f), heap.LargestFreeBlock() / (1024.0f*1024.0f));
+			ImGui::BulletText(text.data());
+
+			text = formater.Format("Fragmentation: {:.2f}%", heap.Fragmentation() * 100.0f);
+			ImGui::BulletText(text.data());
+
+			for (uint32 tag = 0; tag < Tags_Count; ++tag)
+			{
+				auto& stats = heap.Stats[tag];
+				if (stats.Allocations == 0) continue;
+
+				text = formater.Format("[{}] : {} allocs, {:.2f} KBs used, {:.2f} KBs slack, {:.2f} KBs peak",
+									   gSystemTagNames[tag], stats.Allocations, stats.Used / 1024.0f,
+									   (stats.Used - stats.Requested) / 1024.0f, stats.PeakUsed / 1024.0f);
+				ImGui::BulletText(text.data());
+			}
 
 			ImGui::Separator();
 
@@ -135,6 +180,23 @@ void App::Update(float dt)
 			displayTimingBlocksOfType(Phase_Rendering);
 			displayTimingBlocksOfType(Phase_Update);
 
+			ImGui::Separator();
+
+			auto& graph = Telemetry::LastTaskGraph;
+			ImGui::Text("Task Graph:");
+
+			text = formater.Format("Critical path: {} cycles of {} cycles of work; the graph took {} cycles", graph.CriticalPathCycles, graph.WorkCycles, graph.GraphCycles);
+			ImGui::BulletText(text.data());
+
+			for (uint32 i = 0; i < graph.CriticalPathLength; ++i)
+			{
+				text = formater.Format("[{}] {}", i, graph.CriticalPath[i]);
+				ImGui::BulletText(text.data());
+			}
+
+			text = formater.Format("Render latency: {} frames, {} cycles{}", Telemetry::RenderLatencyFrames, Telemetry::RenderLatencyCycles, Arguments.Pipelined ? " (pipelined)" : "");
+			ImGui::BulletText(text.data());
+
 			ImGui::Separator();
 			
 			ImGui::Text("Performance:");
@@ -14,6 +14,9 @@
 struct CommandLineSettings
 {
 	std::string_view ResourcesPath;
+	// @Note: The game simulates the next frame while the current one is
+	// rendered; see SpaceGame::Update
+	bool Pipelined;
 };
 
 /*
@@ -6,6 +6,7 @@
 #include <Audio.hpp>
 #include <FontLibrary.hpp>
 #include <Timing.hpp>
+#include <Jobs.hpp>
 
 // @Note: I hope this gets inlined; is is there because I am lazy at typing
 template<typename T>
@@ -19,7 +20,9 @@ static void* GetData(MemoryArena& fileArena, size_t offset)
 	return fileArena.Memory + offset;
 }
 
-void AssetStore::LoadAssetFile(AssetFile file, AssetBuildingContext& context)
+// @Note: When loading for a level, every id that ends up in one of the
+// libraries is also written down in the level record
+static void LoadAssets(AssetFile file, AssetBuildingContext& context, LevelRecord* level)
 {
 	DxProfileCode(DxTimedBlock(Phase_Init, "Asset loading"));
 	MemoryArena fileArena = Memory::GetTempArena(file.Size + Kilobytes(1));
@@ -34,14 +37,32 @@ void AssetStore::LoadAssetFile(AssetFile file, AssetBuildingContext& context)
 
 	auto header = ReadBlob<AssetColletionHeader>(current);
 
-	context.ImageLib->Images.reserve(header.LoadImagesCount + header.ImagesCount);
-	context.WavLib->AudioEntries.reserve(header.LoadWavsCount);
-	context.FontLib->AtlasGlyphEntries.resize(header.LoadFontsCount * FontLibrary::Characters.size());
+	context.ImageLib->Images.reserve(context.ImageLib->Images.size() + header.LoadImagesCount + header.ImagesCount);
+	if (context.MeshesLib) context.MeshesLib->Materials.BindViews.reserve(context.MeshesLib->Materials.BindViews.size() + header.MaterialsCount);
+	context.WavLib->AudioEntries.reserve(context.WavLib->AudioEntries.size() + header.LoadWavsCount);
+	context.FontLib->IdMap.reserve(context.FontLib->IdMap.size() + header.LoadFontsCount);
+	if (context.MeshesLib) context.MeshesLib->Meshes.reserve(context.MeshesLib->Meshes.size() + header.LoadMeshesCount);
+	context.FontLib->AtlasGlyphEntries.resize((context.FontLib->IdMap.size() + header.LoadFontsCount) * FontLibrary::Characters.size());
+
+	if (level)
+	{
+		level->Images = Memory::BulkGetType<ImageId>(header.ImagesCount + header.LoadImagesCount);
+		level->Wavs = Memory::BulkGetType<WavId>(header.LoadWavsCount);
+		level->Fonts = Memory::BulkGetType<FontId>(header.LoadFontsCount);
+		level->Meshes = Memory::BulkGetType<MeshId>(header.LoadMeshesCount);
+		level->Materials = Memory::BulkGetType<MaterialId>(header.MaterialsCount);
+		level->Textures = Memory::BulkGetType<TextureId>(header.TexturesCount);
+		level->CubeTextures = Memory::BulkGetType<TextureId>(header.SkyboxesCount);
+		level->VertexBuffers = Memory::BulkGetType<VertexBufferId>(header.VBsCount);
+		level->IndexBuffers = Memory::BulkGetType<IndexBufferId>(header.IBsCount);
+		level->ConstantBuffers = Memory::BulkGetType<ConstantBufferId>(header.MaterialsCount);
+	}
 	
 	for (uint32 i = 0; i < header.TexturesCount; ++i)
 	{
 		const TextureLoadEntry& entry = ReadBlob<TextureLoadEntry>(current);
 		context.Graphics->CreateTexture(entry.Id, entry.Desc, GetData(fileArena, entry));
+		if (level) level->Textures[level->TexturesCount++] = entry.Id;
 	}
 
 	for (uint32 i = 0; i < header.VBsCount; ++i)
@@ -51,12 +72,14 @@ void AssetStore::LoadAssetFile(AssetFile file, AssetBuildingContext& context)
 		context.Graphics->CreateVertexBuffer(entry.Id, entry.StructSize,
 											 GetData(fileArena, entry),
 											 entry.DataSize, entry.Dynamic);
+		if (level) level->VertexBuffers[level->VertexBuffersCount++] = entry.Id;
 	}
 
 	for (uint32 i = 0; i < header.IBsCount; ++i)
 	{
 		const IBLoadEntry& entry = ReadBlob<IBLoadEntry>(current);
 		context.Graphics->CreateIndexBuffer(entry.Id, GetData(fileArena, entry), entry.DataSize);
+		if (level) level->IndexBuffers[level->IndexBuffersCount++] = entry.Id;
 	}
 
 	
@@ -64,30 +87,44 @@ void AssetStore::LoadAssetFile(AssetFile file, AssetBuildingContext& context)
 	{
 		const ImageEntry& entry = ReadBlob<ImageEntry>(current);
 		context.ImageLib->Images.insert({ entry.Id, entry.Image });
+		if (level) level->Images[level->ImagesCount++] = entry.Id;
 	}
 
 	for (uint32 i = 0; i < header.AtlasesCount; ++i)
 	{
 		const ImageAtlas& entry = ReadBlob<ImageAtlas>(current);
+		Assert(context.ImageLib->Atlases.size() < MaxAtlases, "Too many image atlases. Try increasing the maximum atlases number");
 		context.ImageLib->Atlases.push_back(entry);
+		context.ImageLib->RectNodes[context.ImageLib->Atlases.size() - 1] = nullptr;
 	}
 	
 	for (uint32 i = 0; i < header.LoadImagesCount; ++i)
 	{
 		const ImageLoadEntry& entry = ReadBlob<ImageLoadEntry>(current);
 		context.ImageLib->CreateMemoryImage(entry.Id, entry.Desc, GetData(fileArena, entry));
+		if (level) level->Images[level->ImagesCount++] = entry.Id;
 	}	
 	
+	// @Note: Creating a wav only talks to OpenAL which can be called from
+	// any thread, so the wavs are created as jobs while this thread goes on
+	// with the rest; they all insert into the concurrent registry of the
+	// player at the same time
+	JobCounter wavs;
 	for (uint32 i = 0; i < header.LoadWavsCount; ++i)
 	{
-		const WavLoadEntry& entry = ReadBlob<WavLoadEntry>(current);
-		context.WavLib->CreateMemoryWav(entry.Id, entry.Desc, GetData(fileArena, entry));
+		const WavLoadEntry* entry = &ReadBlob<WavLoadEntry>(current);
+		void* data = GetData(fileArena, *entry);
+		AudioPlayer* player = context.WavLib;
+		if (JobSystem::g_Worker) JobSystem::Run(wavs, [player, entry, data]() { player->CreateMemoryWav(entry->Id, entry->Desc, data); });
+		else player->CreateMemoryWav(entry->Id, entry->Desc, data);
+		if (level) level->Wavs[level->WavsCount++] = entry->Id;
 	}	
 
 	for (uint32 i = 0; i < header.LoadFontsCount; ++i)
 	{
 		FontLoadEntry& entry = ReadBlob<FontLoadEntry>(current);
 		context.FontLib->CreateMemoryTypeface(entry.Id, entry.Desc, GetData(fileArena, entry), entry.DataSize);
+		if (level) level->Fonts[level->FontsCount++] = entry.Id;
 	}
 		
 	for (uint32 i = 0; i < header.SkyboxesCount; ++i)
@@ -103,6 +140,7 @@ void AssetStore::LoadAssetFile(AssetFile file, AssetBuildingContext& context)
 			GetData(fileArena, entry.DataOffset[5]), 
 		};
 		context.Graphics->CreateCubeTexture(entry.Id, entry.Desc, datas);
+		if (level) level->CubeTextures[level->CubeTexturesCount++] = entry.Id;
 	}
 
 	for (uint32 i = 0; i < header.LoadMeshesCount; ++i)
@@ -110,13 +148,20 @@ void AssetStore::LoadAssetFile(AssetFile file, AssetBuildingContext& context)
 		MeshLoadEntry& entry = ReadBlob<MeshLoadEntry>(current); 
 		// @Todo: Make this into something better; probalby just skip the entries for which we can't do anything
 		// in the asset loading context
-		if (context.MeshesLib) context.MeshesLib->Meshes.insert({ MeshId{entry.Id}, entry.Mesh });
+		if (!context.MeshesLib) continue;
+		context.MeshesLib->Meshes.insert({ MeshId{entry.Id}, entry.Mesh });
+		if (level) level->Meshes[level->MeshesCount++] = entry.Id;
 	}
 
 	for (uint32 i = 0; i < header.MaterialsCount; ++i)
 	{
 		MaterialLoadEntry& entry = ReadBlob<MaterialLoadEntry>(current);
 		if (!context.MeshesLib) continue;
+		if (level)
+		{
+			level->Materials[level->MaterialsCount++] = entry.Id;
+			level->ConstantBuffers[level->ConstantBuffersCount++] = entry.Buffer;
+		}
 
 		switch (entry.Desc.Type)
 		{
@@ -141,7 +186,140 @@ void AssetStore::LoadAssetFile(AssetFile file, AssetBuildingContext& context)
 		}
 		
 	}
-	
+
+	// @Note: The wavs read from the file so they have to be done before it goes away
+	if (JobSystem::g_Worker) JobSystem::Wait(wavs);
+
+	// @Note: Everything is loaded, nobody reads from the replaced tables of the registries anymore
+	context.ImageLib->Images.Reclaim();
+	context.WavLib->AudioEntries.Reclaim();
+	context.FontLib->IdMap.Reclaim();
+	if (context.MeshesLib) context.MeshesLib->Meshes.Reclaim();
+}
+
+void AssetStore::LoadAssetFile(AssetFile file, AssetBuildingContext& context)
+{
+	LoadAssets(file, context, nullptr);
+}
+
+void AssetStore::LoadLevel(Tag t_Tag, AssetFile file, AssetBuildingContext& context)
+{
+	auto& level = Levels[t_Tag];
+	Assert(!level.Loaded, "Level [{}] is already loaded", (uint16)t_Tag);
+
+	level = {};
+	level.Bulk = Memory::MarkBulk();
+	level.Loaded = true;
+	LevelsStack[LevelsCount++] = t_Tag;
+
+	auto imageLib = context.ImageLib;
+	auto fontLib = context.FontLib;
+	level.ImageAtlasesCount = imageLib->Atlases.size();
+	level.FontAtlasesCount = fontLib->Atlases.size();
+	level.GlyphEntriesCount = fontLib->AtlasGlyphEntries.size();
+
+	level.FontRectContext = fontLib->RectContext;
+	level.FontRectNodes = fontLib->RectNodes;
+	level.FontRectNodesCopy = Memory::BulkGetType<stbrp_node>(FontLibrary::RectsCount);
+	memcpy(level.FontRectNodesCopy, fontLib->RectNodes, sizeof(stbrp_node) * FontLibrary::RectsCount);
+
+	level.ImageRectNodesCopy = Memory::BulkGetType<stbrp_node>(level.ImageAtlasesCount * RectsCount);
+	for (size_t i = 0; i < level.ImageAtlasesCount; ++i)
+	{
+		level.ImageRectContexts[i] = imageLib->Atlases[i].RectContext;
+		if (imageLib->RectNodes[i]) memcpy(level.ImageRectNodesCopy + i * RectsCount, imageLib->RectNodes[i], sizeof(stbrp_node) * RectsCount);
+	}
+
+	if (context.MeshesLib)
+	{
+		auto& materials = context.MeshesLib->Materials;
+		level.MtlMaterialsCount = materials.MtlMaterials.size();
+		level.PhongMaterialsCount = materials.PhongMaterials.size();
+		level.TexMaterialsCount = materials.TexMaterials.size();
+	}
+
+	LoadAssets(file, context, &level);
+	level.BulkEnd = Memory::MarkBulk();
+}
+
+static bool IsAtlasTexture(const ImageLibrary& t_Library, TextureId t_Texture)
+{
+	for (const auto& atlas : t_Library.Atlases)
+	{
+		if (atlas.TexHandle == t_Texture) return true;
+	}
+	return false;
+}
+
+void AssetStore::UnloadLevel(Tag t_Tag, AssetBuildingContext& context)
+{
+	auto& level = Levels[t_Tag];
+	Assert(level.Loaded, "Level [{}] is not loaded", (uint16)t_Tag);
+	Assert(LevelsStack[LevelsCount - 1] == t_Tag, "Level [{}] has to be unloaded after the levels that were loaded after it", (uint16)t_Tag);
+
+	DXDEBUG("[Init] Unloading level: {}", (uint16)t_Tag);
+
+	auto graphics = context.Graphics;
+	auto imageLib = context.ImageLib;
+
+	// @Note: The images that are too big for the atlases have textures of
+	// their own; the rest are in the atlases or in the textures of the level
+	for (uint32 i = 0; i < level.ImagesCount; ++i)
+	{
+		const Image* image = imageLib->Images.find(level.Images[i]);
+		if (image && !GPUHandle::IsAsset(image->TexHandle) && !IsAtlasTexture(*imageLib, image->TexHandle)) graphics->DestroyTexture(image->TexHandle);
+		imageLib->Images.erase(level.Images[i]);
+	}
+
+	for (size_t i = level.ImageAtlasesCount; i < imageLib->Atlases.size(); ++i)
+	{
+		if (!GPUHandle::IsAsset(imageLib->Atlases[i].TexHandle)) graphics->DestroyTexture(imageLib->Atlases[i].TexHandle);
+	}
+	imageLib->Atlases.resize(level.ImageAtlasesCount);
+	for (size_t i = 0; i < level.ImageAtlasesCount; ++i)
+	{
+		imageLib->Atlases[i].RectContext = level.ImageRectContexts[i];
+		if (imageLib->RectNodes[i]) memcpy(imageLib->RectNodes[i], level.ImageRectNodesCopy + i * RectsCount, sizeof(stbrp_node) * RectsCount);
+	}
+
+	for (uint32 i = 0; i < level.WavsCount; ++i) context.WavLib->DestroyWav(level.Wavs[i]);
+
+	// @Note: The font atlases that the level started are dropped and the
+	// one that was current before the level gets its free space back
+	auto fontLib = context.FontLib;
+	for (uint32 i = 0; i < level.FontsCount; ++i) fontLib->IdMap.erase(level.Fonts[i]);
+	fontLib->AtlasGlyphEntries.resize(level.GlyphEntriesCount);
+	for (size_t i = level.FontAtlasesCount; i < fontLib->Atlases.size(); ++i) graphics->DestroyTexture(fontLib->Atlases[i]);
+	fontLib->Atlases.resize(level.FontAtlasesCount);
+	fontLib->RectContext = level.FontRectContext;
+	fontLib->RectNodes = level.FontRectNodes;
+	memcpy(fontLib->RectNodes, level.FontRectNodesCopy, sizeof(stbrp_node) * FontLibrary::RectsCount);
+
+	if (context.MeshesLib)
+	{
+		for (uint32 i = 0; i < level.MeshesCount; ++i) context.MeshesLib->Meshes.erase(level.Meshes[i]);
+
+		auto& materials = context.MeshesLib->Materials;
+		for (uint32 i = 0; i < level.MaterialsCount; ++i)
+		{
+			materials.UpdateViews.erase(level.Materials[i]);
+			materials.BindViews.erase(level.Materials[i]);
+		}
+		materials.MtlMaterials.resize(level.MtlMaterialsCount);
+		materials.PhongMaterials.resize(level.PhongMaterialsCount);
+		materials.TexMaterials.resize(level.TexMaterialsCount);
+	}
+
+	for (uint32 i = 0; i < level.TexturesCount; ++i) graphics->DestroyTexture(level.Textures[i]);
+	for (uint32 i = 0; i < level.CubeTexturesCount; ++i) graphics->DestroyCubeTexture(level.CubeTextures[i]);
+	for (uint32 i = 0; i < level.VertexBuffersCount; ++i) graphics->DestroyVertexBuffer(level.VertexBuffers[i]);
+	for (uint32 i = 0; i < level.IndexBuffersCount; ++i) graphics->DestroyIndexBuffer(level.IndexBuffers[i]);
+	for (uint32 i = 0; i < level.ConstantBuffersCount; ++i) graphics->DestroyConstantBuffer(level.ConstantBuffers[i]);
+
+	Memory::RollbackBulk(level.Bulk, level.BulkEnd);
+
+	level.Loaded = false;
+	--LevelsCount;
 }
 
 void AssetStore::SetDebugNames(Graphics* Graphics, GPUResource* resources, size_t count)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Types.hpp>
+#include <string_view>
 #include <GraphicsCommon.hpp>
 #include <Memory.hpp>
 #include <ImageLibrary.hpp>
@@ -11,7 +12,9 @@
 
 enum Tag : uint16
 {
-	Tag_Level
+	Tag_Level,
+
+	Tag_Count,
 };
 
 enum GPUResourceType : uint8
@@ -33,6 +36,51 @@ struct GPUResource
 	const char* Name;
 };
 
+/*
+  @Note: The asset builder generates a minimal perfect hash over the names
+  of all the assets in a bundle. A name is first hashed with seed 0 to pick
+  a bucket; the seed stored for that bucket then gives the final slot in
+  [0, count). The builder searches the seeds so that no two names share a
+  slot, thus a lookup is two hashes and one string compare -- and it can be
+  done at compile time as everything here is constexpr.
+*/
+struct AssetName
+{
+	const char* Name;
+	uint32 Id;
+	uint16 Type;
+};
+
+constexpr uint32 AssetNameHash(std::string_view t_Name, uint32 t_Seed)
+{
+	// @Note: FNV-1a with the seed mixed into the offset basis
+	uint32 hash = 2166136261u ^ (t_Seed * 0x9E3779B9u);
+	for (char c : t_Name)
+	{
+		hash ^= uint8(c);
+		hash *= 16777619u;
+	}
+	hash ^= hash >> 15;
+	hash *= 0x2C1B3C6Du;
+	hash ^= hash >> 12;
+	return hash;
+}
+
+// @Note: Returns the dense slot of the name or -1 if the name is not in the table
+constexpr int32 FindAssetSlot(const uint32* t_Seeds, size_t t_SeedsCount, const AssetName* t_Names, size_t t_NamesCount, std::string_view t_Name)
+{
+	if (t_NamesCount == 0) return -1;
+	const uint32 bucket = AssetNameHash(t_Name, 0) % t_SeedsCount;
+	const uint32 slot = AssetNameHash(t_Name, t_Seeds[bucket]) % t_NamesCount;
+	return std::string_view(t_Names[slot].Name) == t_Name ? int32(slot) : -1;
+}
+
+template<size_t SeedsCount, size_t NamesCount>
+constexpr int32 FindAssetSlot(const uint32 (&t_Seeds)[SeedsCount], const AssetName (&t_Names)[NamesCount], std::string_view t_Name)
+{
+	return FindAssetSlot(t_Seeds, SeedsCount, t_Names, NamesCount, t_Name);
+}
+
 struct AssetColletionHeader
 {
 	uint32 TexturesCount;
@@ -167,9 +215,75 @@ struct AssetFile
 	size_t Size;
 };
 
+// @Note: Everything that a level put into the libraries and the GPU; the
+// lists of ids are in the bulk memory that the level itself took so they
+// go away with the rest of it
+struct LevelRecord
+{
+	// @Note: The bulk memory of the level is everything between the two
+	// markers; nothing else may take bulk memory while the level is loaded
+	BulkMarker Bulk;
+	BulkMarker BulkEnd;
+
+	size_t ImageAtlasesCount;
+	size_t FontAtlasesCount;
+	size_t GlyphEntriesCount;
+	size_t MtlMaterialsCount;
+	size_t PhongMaterialsCount;
+	size_t TexMaterialsCount;
+
+	// @Note: The glyphs of the level are packed in the current font atlas
+	// so its packing state is saved and restored on unload
+	stbrp_context FontRectContext;
+	stbrp_node* FontRectNodes;
+	stbrp_node* FontRectNodesCopy;
+
+	// @Note: The images of the level may be packed in the atlases that
+	// were there before it; their packing state is restored on unload as well
+	stbrp_context ImageRectContexts[MaxAtlases];
+	stbrp_node* ImageRectNodesCopy;
+
+	ImageId* Images;
+	WavId* Wavs;
+	FontId* Fonts;
+	MeshId* Meshes;
+	MaterialId* Materials;
+	uint32 ImagesCount;
+	uint32 WavsCount;
+	uint32 FontsCount;
+	uint32 MeshesCount;
+	uint32 MaterialsCount;
+
+	TextureId* Textures;
+	TextureId* CubeTextures;
+	VertexBufferId* VertexBuffers;
+	IndexBufferId* IndexBuffers;
+	ConstantBufferId* ConstantBuffers;
+	uint32 TexturesCount;
+	uint32 CubeTexturesCount;
+	uint32 VertexBuffersCount;
+	uint32 IndexBuffersCount;
+	uint32 ConstantBuffersCount;
+
+	bool Loaded;
+};
+
 struct AssetStore
 {
+	// @Note: The levels can only be unloaded in the reverse order of their
+	// loading; the bulk memory is rolled back like a stack
+	inline static LevelRecord Levels[Tag_Count];
+	inline static Tag LevelsStack[Tag_Count];
+	inline static uint32 LevelsCount;
+
 	static void LoadAssetFile(AssetFile file, AssetBuildingContext& builders);
 
+	// @Note: Load an asset file for the level with the given tag;
+	// everything it brings stays until UnloadLevel is called for the tag.
+	// The level has to be the last thing that takes bulk memory until it
+	// is unloaded
+	static void LoadLevel(Tag t_Tag, AssetFile file, AssetBuildingContext& builders);
+	static void UnloadLevel(Tag t_Tag, AssetBuildingContext& builders);
+
 	static void SetDebugNames(Graphics* Graphics, GPUResource* resources, size_t counts);
 };
@@ -98,7 +98,7 @@ uint32 AudioBuilder::PutWav(std::string_view t_Path)
 void AudioPlayer::Build(AudioBuilder& t_Builder)
 {
 	MemoryArena fileArena = Memory::GetTempArena(t_Builder.MaxFileSize + Megabytes(1));
-	Memory::EstablishTempScope(Megabytes(64));
+	Memory::EstablishTempScope();
 	Defer {
 		Memory::EndTempScope();
 		Memory::DestoryTempArena(fileArena);
@@ -150,7 +150,7 @@ void AudioPlayer::Build(AudioBuilder& t_Builder)
 
 void AudioPlayer::Play(WavId t_Id, float t_Gain)
 {
-	const auto source =  AudioEntries[t_Id].Source;
+	const auto source =  AudioEntries.at(t_Id).Source;
 	alSourcef(source, AL_GAIN, t_Gain);
 	alSourcePlay(source);
 }
@@ -168,3 +168,16 @@ void AudioPlayer::CreateMemoryWav(WavId id, const WavDescription& desc, void* da
 	AudioEntries.insert({id, AudioEntry{bufferid, sourceid}});
 	Telemetry::AddMemory(Memory_Audio, desc.Size);
 }
+
+void AudioPlayer::DestroyWav(WavId id)
+{
+	const auto entry = AudioEntries.at(id);
+
+	ALint size;
+	alGetBufferi(entry.Buffer, AL_SIZE, &size);
+	Telemetry::RemoveMemory(Memory_Audio, size);
+
+	alDeleteSources(1, &entry.Source);
+	alDeleteBuffers(1, &entry.Buffer);
+	AudioEntries.erase(id);
+}
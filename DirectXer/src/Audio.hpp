@@ -4,6 +4,7 @@
 #include <Resources.hpp>
 #include <Fileutils.hpp>
 #include <Containers.hpp>
+#include <ConcurrentMap.hpp>
 
 #include <AL/al.h>
 #include <AL/alext.h>
@@ -52,8 +53,9 @@ class AudioPlayer
 		unsigned Source;
 	};
 
-	Map<WavId, AudioEntry, Memory_Audio> AudioEntries;
+	ConcurrentMap<WavId, AudioEntry, Memory_Audio> AudioEntries;
 	void Build(AudioBuilder& t_Builder);
 	void CreateMemoryWav(WavId id, const WavDescription& desc, void* data);
+	void DestroyWav(WavId id);
 	void Play(uint32 t_Id, float t_Gain);
 };
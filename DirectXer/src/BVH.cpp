@@ -53,7 +53,7 @@ void InsertAABB(SlowBVH& bvh, AABB aabb)
 		return;
 	}
 
-	Memory::EstablishTempScope(Megabytes(3));
+	Memory::EstablishTempScope();
 	Defer{
 		Memory::EndTempScope();
 	};
@@ -64,8 +64,9 @@ void InsertAABB(SlowBVH& bvh, AABB aabb)
 
 	float delta = Area(aabb);
 
-	TempVector<Node> stack;
-	stack.reserve(2048);
+	// @Note: The stack is never deeper than the tree; only really unbalanced
+	// trees spill into the temporary memory
+	SmallVector<Node, 64> stack;
 	stack.push_back({bvh.RootIndex, bestCost - Area(nodes[best].box)});
 	while (!stack.empty())
 	{
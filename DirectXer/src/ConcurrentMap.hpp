@@ -0,0 +1,276 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Utils.hpp>
+#include <Tags.hpp>
+#include <Memory.hpp>
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <type_traits>
+#include <robin_hood.h>
+
+/*
+  @Note: Hash map that any thread can read while other threads insert into
+  it; this is what the asset registries are -- the loaders fill them and
+  the frame looks things up in them.
+
+  Reads never lock nor wait. The table is published through an atomic
+  pointer and every slot has an atomic state; a writer fills the key and
+  the value of a slot first and only then marks it as full. Once full, a
+  slot is never written again -- erasing only marks it as deleted and the
+  deleted slots are not reused until the next rebuild. A reader can thus
+  never see half of an entry and the references that it gets stay valid
+  even after the entry is erased.
+
+  The writers take a short lock; inserting is nothing compared to loading
+  the asset that goes into the map. When the table runs out of room, the
+  entries are copied into a new one and the old table is retired instead
+  of freed as somebody may still be reading from it. The retired tables
+  are freed by Reclaim() which has to be called at a point where no other
+  thread reads from the map (the end of the asset loading for example).
+
+  Growing copies the whole table, so the main thread should reserve() the
+  room for everything that the loaders are going to insert before
+  starting them.
+*/
+template<class Key, class Value, SystemTag Tag = Tag_Unknown, class Hash = robin_hood::hash<Key>>
+struct ConcurrentMap
+{
+	static_assert(std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>, "The concurrent map can only hold trivially copyable types");
+
+	inline static const uint8 SlotEmpty = 0;
+	inline static const uint8 SlotFull = 1;
+	inline static const uint8 SlotDeleted = 2;
+	inline static const size_t MinCapacity = 16;
+	inline static const Value Missing{};
+
+	struct Table
+	{
+		size_t Capacity;
+		Table* NextRetired;
+		Key* Keys;
+		Value* Values;
+		std::atomic<uint8>* States;
+	};
+
+	std::atomic<Table*> Current{nullptr};
+	std::atomic<size_t> Count{0};
+
+	// @Note: Only touched under the write lock
+	size_t Tombstones{0};
+	Table* Retired{nullptr};
+	std::atomic<bool> WriteLock{false};
+
+	ConcurrentMap() = default;
+	ConcurrentMap(const ConcurrentMap&) = delete;
+	ConcurrentMap& operator=(const ConcurrentMap&) = delete;
+
+	~ConcurrentMap()
+	{
+		Reclaim();
+		Memory::HeapFree(Current.load(std::memory_order_relaxed));
+	}
+
+	size_t size() const { return Count.load(std::memory_order_relaxed); }
+	bool empty() const { return size() == 0; }
+
+	// @Note: Wait-free; the returned value stays valid until the next Reclaim()
+	const Value* find(const Key& t_Key) const
+	{
+		const Table* table = Current.load(std::memory_order_acquire);
+		if (!table) return nullptr;
+
+		const size_t mask = table->Capacity - 1;
+		size_t index = Hash{}(t_Key) & mask;
+		for (size_t probe = 0; probe < table->Capacity; ++probe, index = (index + 1) & mask)
+		{
+			const uint8 state = table->States[index].load(std::memory_order_acquire);
+			if (state == SlotEmpty) return nullptr;
+			if (state == SlotFull && table->Keys[index] == t_Key) return &table->Values[index];
+		}
+		return nullptr;
+	}
+
+	bool contains(const Key& t_Key) const { return find(t_Key) != nullptr; }
+
+	// @Note: A key that is not in the map is a bug; the debug builds stop on
+	// it and the release ones get a zeroed value (texture 0, source 0, etc.)
+	// instead of reading through a null pointer
+	const Value& at(const Key& t_Key) const
+	{
+		const Value* value = find(t_Key);
+		Assert(value, "The key is not in the map");
+		return value ? *value : Missing;
+	}
+
+	// @Note: Returns false if the key is already in the map; its value is
+	// not changed then
+	bool insert(const Key& t_Key, const Value& t_Value)
+	{
+		Lock();
+		Defer {
+			Unlock();
+		};
+
+		Table* table = Current.load(std::memory_order_relaxed);
+		const size_t count = Count.load(std::memory_order_relaxed);
+		if (!table || count + Tombstones + 1 > MaxLoad(table->Capacity))
+		{
+			// @Note: A table that is mostly tombstones is rebuilt with the same size
+			const size_t capacity = !table ? MinCapacity : (count + 1 > MaxLoad(table->Capacity) / 2 ? table->Capacity * 2 : table->Capacity);
+			table = Rebuild(capacity);
+		}
+
+		const size_t mask = table->Capacity - 1;
+		size_t index = Hash{}(t_Key) & mask;
+		while (true)
+		{
+			const uint8 state = table->States[index].load(std::memory_order_relaxed);
+			if (state == SlotEmpty) break;
+			if (state == SlotFull && table->Keys[index] == t_Key) return false;
+			index = (index + 1) & mask;
+		}
+
+		table->Keys[index] = t_Key;
+		table->Values[index] = t_Value;
+		table->States[index].store(SlotFull, std::memory_order_release);
+		Count.store(count + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool insert(const std::pair<Key, Value>& t_Entry)
+	{
+		return insert(t_Entry.first, t_Entry.second);
+	}
+
+	size_t erase(const Key& t_Key)
+	{
+		Lock();
+		Defer {
+			Unlock();
+		};
+
+		Table* table = Current.load(std::memory_order_relaxed);
+		if (!table) return 0;
+
+		const size_t mask = table->Capacity - 1;
+		size_t index = Hash{}(t_Key) & mask;
+		for (size_t probe = 0; probe < table->Capacity; ++probe, index = (index + 1) & mask)
+		{
+			const uint8 state = table->States[index].load(std::memory_order_relaxed);
+			if (state == SlotEmpty) return 0;
+			if (state == SlotFull && table->Keys[index] == t_Key)
+			{
+				table->States[index].store(SlotDeleted, std::memory_order_release);
+				Count.fetch_sub(1, std::memory_order_relaxed);
+				++Tombstones;
+				return 1;
+			}
+		}
+		return 0;
+	}
+
+	// @Note: Make room for t_Count entries in total so that no insert has
+	// to rebuild the table before that
+	void reserve(size_t t_Count)
+	{
+		Lock();
+		Defer {
+			Unlock();
+		};
+
+		size_t capacity = MinCapacity;
+		while (MaxLoad(capacity) < t_Count) capacity *= 2;
+
+		// @Note: The tombstones take room as well until the table is rebuilt
+		Table* table = Current.load(std::memory_order_relaxed);
+		if (!table) Rebuild(capacity);
+		else if (t_Count + Tombstones > MaxLoad(table->Capacity)) Rebuild(capacity > table->Capacity ? capacity : table->Capacity);
+	}
+
+	// @Note: Frees the tables that were replaced by bigger ones; nobody may
+	// be reading from the map while this runs
+	void Reclaim()
+	{
+		Lock();
+		Defer {
+			Unlock();
+		};
+
+		while (Retired)
+		{
+			Table* next = Retired->NextRetired;
+			Memory::HeapFree(Retired);
+			Retired = next;
+		}
+	}
+
+  private:
+
+	static size_t MaxLoad(size_t t_Capacity) { return t_Capacity - t_Capacity / 4; }
+
+	static size_t AlignUp(size_t t_Offset, size_t t_Align) { return (t_Offset + t_Align - 1) & ~(t_Align - 1); }
+
+	void Lock()
+	{
+		while (WriteLock.exchange(true, std::memory_order_acquire)) std::this_thread::yield();
+	}
+
+	void Unlock()
+	{
+		WriteLock.store(false, std::memory_order_release);
+	}
+
+	// @Note: The header of the table, its keys, values and states are all
+	// in a single heap block
+	static Table* NewTable(size_t t_Capacity)
+	{
+		const size_t keysOffset = AlignUp(sizeof(Table), alignof(Key));
+		const size_t valuesOffset = AlignUp(keysOffset + t_Capacity * sizeof(Key), alignof(Value));
+		const size_t statesOffset = valuesOffset + t_Capacity * sizeof(Value);
+		const size_t align = alignof(Key) > alignof(Value) ? alignof(Key) : alignof(Value);
+
+		char* block = (char*)Memory::HeapAlloc(statesOffset + t_Capacity, Tag, align > alignof(Table) ? align : alignof(Table));
+		Table* table = (Table*)block;
+		table->Capacity = t_Capacity;
+		table->NextRetired = nullptr;
+		table->Keys = (Key*)(block + keysOffset);
+		table->Values = (Value*)(block + valuesOffset);
+		table->States = (std::atomic<uint8>*)(block + statesOffset);
+		for (size_t i = 0; i < t_Capacity; ++i) new (&table->States[i]) std::atomic<uint8>(SlotEmpty);
+		return table;
+	}
+
+	// @Note: The new table is filled completely before it is published so
+	// a reader sees either all of the old table or all of the new one
+	Table* Rebuild(size_t t_Capacity)
+	{
+		Table* table = NewTable(t_Capacity);
+		const size_t mask = t_Capacity - 1;
+
+		Table* old = Current.load(std::memory_order_relaxed);
+		if (old)
+		{
+			for (size_t i = 0; i < old->Capacity; ++i)
+			{
+				if (old->States[i].load(std::memory_order_relaxed) != SlotFull) continue;
+
+				size_t index = Hash{}(old->Keys[i]) & mask;
+				while (table->States[index].load(std::memory_order_relaxed) != SlotEmpty) index = (index + 1) & mask;
+
+				table->Keys[index] = old->Keys[i];
+				table->Values[index] = old->Values[i];
+				table->States[index].store(SlotFull, std::memory_order_relaxed);
+			}
+
+			old->NextRetired = Retired;
+			Retired = old;
+		}
+
+		Tombstones = 0;
+		Current.store(table, std::memory_order_release);
+		return table;
+	}
+};
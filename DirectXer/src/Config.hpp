@@ -18,6 +18,11 @@ static inline const bool DebugBuild = false;
 // only to check if there are some memory leaks
 static inline const bool CleanDestroy = false;
 
+// @Note: What the allocators align to when nobody asks for something
+// more specific; enough for SSE types
+const static inline size_t DefaultAlignment = 16u;
+const static inline size_t CacheLineSize = 64u;
+
 const static inline uint16 RectsCount = 1024u / 2u;
 const static inline uint16 ImageAtlasSize = 1024u;
 const static inline uint8 MaxAtlases = 10u;
@@ -32,5 +37,8 @@ struct Config
 	const static inline uint16 InitialMaxConstantBuffers = 32u;
 
 	const static inline bool EnableCycleCounters = true;
+
+	// @Note: The most tasks that a frame task graph can have
+	const static inline uint32 MaxFrameTasks = 32u;
 };
 
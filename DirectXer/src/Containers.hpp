@@ -10,6 +10,8 @@
 #include <vector>
 #include <string>
 #include <robin_hood.h>
+#include <type_traits>
+#include <cstring>
 
 #if USE_CUSTOM_ALLOCATORS
 
@@ -18,13 +20,12 @@ struct RobinAllocator
 {
 	static  void* malloc(size_t size)
 	{
-		//return std::malloc(size);
-		return Memory::BulkGet(size, Tag);
+		return Memory::HeapAlloc(size, Tag);
 	}
 
 	static void free(void* ptr)
 	{
-		//std::free(ptr);
+		Memory::HeapFree(ptr);
 	}
 };
 
@@ -38,6 +39,13 @@ using BulkVector = std::vector<T, BulkStdAllocator<T, Tag>>;
 using BulkString = std::basic_string<char, std::char_traits<char>, BulkStdAllocator<char>>;
 using BulkWString = std::basic_string<wchar_t, std::char_traits<wchar_t>, BulkStdAllocator<wchar_t>>;
 
+// @Note: The storage starts on a cache line; SIMD code can use aligned
+// loads on it and data of different threads doesn't share cache lines
+template<class T>
+using CacheAlignedTempVector = std::vector<T, TempStdAllocator<T, CacheLineSize>>;
+template<class T, SystemTag Tag = Tag_Unknown>
+using CacheAlignedBulkVector = std::vector<T, BulkStdAllocator<T, Tag, CacheLineSize>>;
+
 using String = std::string_view;
 
 template<class Key, class Value, SystemTag Tag = Tag_Unknown>
@@ -53,6 +61,11 @@ template<class T>
 using BulkVector = std::vector<T>;
 using BulkString = std::string;
 
+template<class T>
+using CacheAlignedTempVector = std::vector<T>;
+template<class T>
+using CacheAlignedBulkVector = std::vector<T>;
+
 using String = std::string_view;
 
 template<class Key, class Value>
@@ -60,4 +73,148 @@ using Map = robin_hood::unordered_map<Key, Value>;
 
 #endif
 
+// @Note: Non owning view over contiguous elements
+template<class T>
+struct Span
+{
+	T* Data{nullptr};
+	size_t Size{0};
+
+	T* begin() const { return Data; }
+	T* end() const { return Data + Size; }
+	T* data() const { return Data; }
+	size_t size() const { return Size; }
+	bool empty() const { return Size == 0; }
+	T& operator[](size_t t_Index) const { return Data[t_Index]; }
+};
+
+/*
+  @Note: Vector with room for N elements inside of itself; only when more
+  than N elements are pushed does it take memory from the allocator (the
+  temp memory of the calling thread by default, so it works on the job
+  threads too). Meant for the short lived lists of the hot paths that
+  almost always fit in N elements. The elements are moved around with
+  memcpy so they have to be trivially copyable.
+*/
+template<class T, size_t N, class Allocator = TempStdAllocator<T>>
+struct SmallVector
+{
+	static_assert(std::is_trivially_copyable_v<T>, "SmallVector can only hold trivially copyable types");
 
+	T* Spilled{nullptr};
+	size_t Size{0};
+	size_t Capacity{N};
+	alignas(T) char Inline[N * sizeof(T)];
+
+	SmallVector() = default;
+	SmallVector(const SmallVector&) = delete;
+	SmallVector& operator=(const SmallVector&) = delete;
+
+	~SmallVector()
+	{
+		if (Spilled) Allocator{}.deallocate(Spilled, Capacity);
+	}
+
+	T* data() { return Spilled ? Spilled : (T*)Inline; }
+	const T* data() const { return Spilled ? Spilled : (const T*)Inline; }
+
+	T* begin() { return data(); }
+	T* end() { return data() + Size; }
+	const T* begin() const { return data(); }
+	const T* end() const { return data() + Size; }
+
+	size_t size() const { return Size; }
+	size_t capacity() const { return Capacity; }
+	bool empty() const { return Size == 0; }
+	bool spilled() const { return Spilled != nullptr; }
+
+	T& operator[](size_t t_Index) { return data()[t_Index]; }
+	const T& operator[](size_t t_Index) const { return data()[t_Index]; }
+	T& back() { return data()[Size - 1]; }
+	const T& back() const { return data()[Size - 1]; }
+
+	void clear() { Size = 0; }
+	void pop_back() { --Size; }
+
+	void reserve(size_t t_Capacity)
+	{
+		if (t_Capacity <= Capacity) return;
+
+		T* memory = Allocator{}.allocate(t_Capacity);
+		std::memcpy(memory, data(), Size * sizeof(T));
+		if (Spilled) Allocator{}.deallocate(Spilled, Capacity);
+
+		Spilled = memory;
+		Capacity = t_Capacity;
+	}
+
+	void resize(size_t t_Size)
+	{
+		reserve(t_Size);
+		Size = t_Size;
+	}
+
+	void push_back(const T& t_Value)
+	{
+		if (Size == Capacity) reserve(Capacity * 2);
+		data()[Size++] = t_Value;
+	}
+
+	template<class... Args>
+	T& emplace_back(Args&&... t_Args)
+	{
+		if (Size == Capacity) reserve(Capacity * 2);
+		return *new (data() + Size++) T{std::forward<Args>(t_Args)...};
+	}
+};
+
+// @Note: Vector with a fixed capacity that lives entirely inside of itself;
+// it never allocates and going over the capacity is an error
+template<class T, size_t N>
+struct StaticVector
+{
+	static_assert(std::is_trivially_copyable_v<T>, "StaticVector can only hold trivially copyable types");
+
+	size_t Size{0};
+	alignas(T) char Storage[N * sizeof(T)];
+
+	T* data() { return (T*)Storage; }
+	const T* data() const { return (const T*)Storage; }
+
+	T* begin() { return data(); }
+	T* end() { return data() + Size; }
+	const T* begin() const { return data(); }
+	const T* end() const { return data() + Size; }
+
+	size_t size() const { return Size; }
+	static constexpr size_t capacity() { return N; }
+	bool empty() const { return Size == 0; }
+	bool full() const { return Size == N; }
+
+	T& operator[](size_t t_Index) { return data()[t_Index]; }
+	const T& operator[](size_t t_Index) const { return data()[t_Index]; }
+	T& back() { return data()[Size - 1]; }
+	const T& back() const { return data()[Size - 1]; }
+
+	void clear() { Size = 0; }
+	void pop_back() { --Size; }
+
+	void resize(size_t t_Size)
+	{
+		Assert(t_Size <= N, "StaticVector can hold only {} elements", N);
+		Size = t_Size;
+	}
+
+	void push_back(const T& t_Value)
+	{
+		Assert(Size < N, "StaticVector can hold only {} elements", N);
+		data()[Size++] = t_Value;
+	}
+
+	template<class... Args>
+	T& emplace_back(Args&&... t_Args)
+	{
+		Assert(Size < N, "StaticVector can hold only {} elements", N);
+		return *new (data() + Size++) T{std::forward<Args>(t_Args)...};
+	}
+};
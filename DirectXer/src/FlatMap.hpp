@@ -0,0 +1,336 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Utils.hpp>
+#include <Tags.hpp>
+#include <Memory.hpp>
+
+#include <utility>
+#include <cstring>
+#include <robin_hood.h>
+
+/*
+  @Note: Open addressing hash map that keeps all of its data in a single
+  block of heap memory -- the entries first and a control byte per entry
+  after them. The control byte is either Empty, Deleted or the lowest 7
+  bits of the hash of the key in the entry so most of the probing never
+  touches the keys.
+
+  The map never leaks its old table. When it runs out of room it first
+  tries to drop its tombstones in place; if it really has to grow, it
+  asks the heap to expand the block where it is and rehashes in place.
+  Only if the block can't be expanded is a new one allocated and the old
+  one freed. reserve() takes an exact count of entries so a map filled
+  from known counts (the asset file header for example) never rehashes.
+*/
+template<class Key, class Value, SystemTag Tag = Tag_Unknown, class Hash = robin_hood::hash<Key>>
+struct FlatMap
+{
+	using Entry = std::pair<Key, Value>;
+
+	inline static const uint8 Empty = 0x80;
+	inline static const uint8 Deleted = 0xFE;
+	inline static const size_t MinCapacity = 8;
+
+	Entry* Entries{nullptr};
+	uint8* Control{nullptr};
+	size_t Capacity{0};
+	size_t Count{0};
+	size_t Tombstones{0};
+
+	template<class EntryType, class MapType>
+	struct Iterator
+	{
+		MapType* Map;
+		size_t Index;
+
+		EntryType& operator*() const { return Map->Entries[Index]; }
+		EntryType* operator->() const { return &Map->Entries[Index]; }
+		bool operator==(const Iterator& t_Other) const { return Index == t_Other.Index; }
+		bool operator!=(const Iterator& t_Other) const { return Index != t_Other.Index; }
+
+		Iterator& operator++()
+		{
+			++Index;
+			while (Index < Map->Capacity && !IsFull(Map->Control[Index])) ++Index;
+			return *this;
+		}
+	};
+
+	using iterator = Iterator<Entry, FlatMap>;
+	using const_iterator = Iterator<const Entry, const FlatMap>;
+
+	FlatMap() = default;
+	FlatMap(const FlatMap&) = delete;
+	FlatMap& operator=(const FlatMap&) = delete;
+
+	~FlatMap()
+	{
+		if (!Entries) return;
+		clear();
+		Memory::HeapFree(Entries);
+	}
+
+	iterator begin() { return { this, FirstFull() }; }
+	iterator end() { return { this, Capacity }; }
+	const_iterator begin() const { return { this, FirstFull() }; }
+	const_iterator end() const { return { this, Capacity }; }
+
+	size_t size() const { return Count; }
+	bool empty() const { return Count == 0; }
+
+	// @Note: Make room for exactly t_Count entries without any rehashing
+	void reserve(size_t t_Count)
+	{
+		size_t capacity = MinCapacity;
+		while (MaxLoad(capacity) < t_Count) capacity *= 2;
+		if (capacity > Capacity) Grow(capacity);
+	}
+
+	void clear()
+	{
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			if (IsFull(Control[i])) Entries[i].~Entry();
+			Control[i] = Empty;
+		}
+		Count = 0;
+		Tombstones = 0;
+	}
+
+	iterator find(const Key& t_Key) { return { this, Find(t_Key) }; }
+	const_iterator find(const Key& t_Key) const { return { this, Find(t_Key) }; }
+	size_t count(const Key& t_Key) const { return Find(t_Key) != Capacity ? 1 : 0; }
+	bool contains(const Key& t_Key) const { return Find(t_Key) != Capacity; }
+
+	Value& at(const Key& t_Key)
+	{
+		const size_t index = Find(t_Key);
+		Assert(index != Capacity, "The key is not in the map");
+		return Entries[index].second;
+	}
+
+	const Value& at(const Key& t_Key) const
+	{
+		const size_t index = Find(t_Key);
+		Assert(index != Capacity, "The key is not in the map");
+		return Entries[index].second;
+	}
+
+	Value& operator[](const Key& t_Key)
+	{
+		return emplace(t_Key, Value{}).first->second;
+	}
+
+	std::pair<iterator, bool> insert(const Entry& t_Entry)
+	{
+		return emplace(t_Entry.first, t_Entry.second);
+	}
+
+	template<class... Args>
+	std::pair<iterator, bool> emplace(const Key& t_Key, Args&&... t_Args)
+	{
+		const size_t hash = Hash{}(t_Key);
+		const uint8 tag = ControlTag(hash);
+
+		size_t slot = Capacity;
+		if (Capacity)
+		{
+			const size_t mask = Capacity - 1;
+			for (size_t i = HomeSlot(hash);; i = (i + 1) & mask)
+			{
+				const uint8 control = Control[i];
+				if (control == tag && Entries[i].first == t_Key) return { { this, i }, false };
+				if (control == Deleted && slot == Capacity) slot = i;
+				if (control == Empty)
+				{
+					if (slot == Capacity) slot = i;
+					break;
+				}
+			}
+		}
+
+		// @Note: Reusing a tombstone never makes the probing longer
+		if (slot == Capacity || Control[slot] == Empty)
+		{
+			if (Count + Tombstones + 1 > MaxLoad(Capacity))
+			{
+				MakeRoom();
+				slot = FreeSlot(hash);
+			}
+		}
+		else
+		{
+			--Tombstones;
+		}
+
+		new (&Entries[slot]) Entry(t_Key, Value(std::forward<Args>(t_Args)...));
+		Control[slot] = tag;
+		++Count;
+
+		return { { this, slot }, true };
+	}
+
+	size_t erase(const Key& t_Key)
+	{
+		const size_t index = Find(t_Key);
+		if (index == Capacity) return 0;
+		EraseSlot(index);
+		return 1;
+	}
+
+	iterator erase(iterator t_It)
+	{
+		EraseSlot(t_It.Index);
+		return ++t_It;
+	}
+
+  private:
+
+	static bool IsFull(uint8 t_Control) { return (t_Control & 0x80) == 0; }
+	static uint8 ControlTag(size_t t_Hash) { return uint8(t_Hash & 0x7F); }
+	static size_t MaxLoad(size_t t_Capacity) { return t_Capacity - t_Capacity / 8; }
+	static size_t BlockSize(size_t t_Capacity) { return t_Capacity * sizeof(Entry) + t_Capacity; }
+
+	size_t HomeSlot(size_t t_Hash) const { return (t_Hash >> 7) & (Capacity - 1); }
+
+	size_t FirstFull() const
+	{
+		size_t index = 0;
+		while (index < Capacity && !IsFull(Control[index])) ++index;
+		return index;
+	}
+
+	size_t Find(const Key& t_Key) const
+	{
+		if (Count == 0) return Capacity;
+
+		const size_t hash = Hash{}(t_Key);
+		const uint8 tag = ControlTag(hash);
+		const size_t mask = Capacity - 1;
+		for (size_t i = HomeSlot(hash);; i = (i + 1) & mask)
+		{
+			const uint8 control = Control[i];
+			if (control == tag && Entries[i].first == t_Key) return i;
+			if (control == Empty) return Capacity;
+		}
+	}
+
+	size_t FreeSlot(size_t t_Hash) const
+	{
+		const size_t mask = Capacity - 1;
+		size_t i = HomeSlot(t_Hash);
+		while (IsFull(Control[i])) i = (i + 1) & mask;
+		return i;
+	}
+
+	void EraseSlot(size_t t_Index)
+	{
+		Entries[t_Index].~Entry();
+		--Count;
+
+		// @Note: No probe sequence goes over an empty slot, so if the next
+		// slot is empty this one does not have to be a tombstone
+		if (Control[(t_Index + 1) & (Capacity - 1)] == Empty)
+		{
+			Control[t_Index] = Empty;
+		}
+		else
+		{
+			Control[t_Index] = Deleted;
+			++Tombstones;
+		}
+	}
+
+	void MakeRoom()
+	{
+		// @Note: If the map is mostly tombstones there is no need for more memory
+		if (Capacity && Count < MaxLoad(Capacity) / 2)
+		{
+			RehashInPlace();
+			return;
+		}
+		Grow(Capacity ? Capacity * 2 : MinCapacity);
+	}
+
+	void Grow(size_t t_Capacity)
+	{
+		if (Entries && Memory::HeapExpand(Entries, BlockSize(t_Capacity)))
+		{
+			// @Note: The control bytes move to the end of the bigger entries
+			// array; the new half of the entries is empty
+			uint8* control = (uint8*)(Entries + t_Capacity);
+			std::memmove(control, Control, Capacity);
+			std::memset(control + Capacity, Empty, t_Capacity - Capacity);
+
+			Control = control;
+			Capacity = t_Capacity;
+			RehashInPlace();
+			return;
+		}
+
+		Entry* oldEntries = Entries;
+		uint8* oldControl = Control;
+		const size_t oldCapacity = Capacity;
+
+		Entries = (Entry*)Memory::HeapAlloc(BlockSize(t_Capacity), Tag, alignof(Entry) > DefaultAlignment ? alignof(Entry) : DefaultAlignment);
+		Control = (uint8*)(Entries + t_Capacity);
+		Capacity = t_Capacity;
+		Tombstones = 0;
+		std::memset(Control, Empty, Capacity);
+
+		for (size_t i = 0; i < oldCapacity; ++i)
+		{
+			if (!IsFull(oldControl[i])) continue;
+
+			const size_t hash = Hash{}(oldEntries[i].first);
+			const size_t slot = FreeSlot(hash);
+			new (&Entries[slot]) Entry(std::move(oldEntries[i]));
+			Control[slot] = ControlTag(hash);
+			oldEntries[i].~Entry();
+		}
+
+		Memory::HeapFree(oldEntries);
+	}
+
+	// @Note: Every live entry is first marked as Deleted (pending) and all
+	// the tombstones become Empty. Then each pending entry walks from its
+	// home slot over the already placed entries; it either stays where it
+	// is, moves to an empty slot or swaps with another pending entry which
+	// is then placed in the same way. The placed entries are never touched
+	// again, thus their probe sequences stay valid.
+	void RehashInPlace()
+	{
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			Control[i] = IsFull(Control[i]) ? Deleted : Empty;
+		}
+		Tombstones = 0;
+
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			while (Control[i] == Deleted)
+			{
+				const size_t hash = Hash{}(Entries[i].first);
+				const size_t slot = FreeSlot(hash);
+
+				if (slot == i)
+				{
+					Control[i] = ControlTag(hash);
+				}
+				else if (Control[slot] == Empty)
+				{
+					new (&Entries[slot]) Entry(std::move(Entries[i]));
+					Entries[i].~Entry();
+					Control[slot] = ControlTag(hash);
+					Control[i] = Empty;
+				}
+				else
+				{
+					std::swap(Entries[i], Entries[slot]);
+					Control[slot] = ControlTag(hash);
+				}
+			}
+		}
+	}
+};
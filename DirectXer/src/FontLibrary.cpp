@@ -45,8 +45,8 @@ void FontLibrary::InitNewAtlas()
 {
 	auto texId = NextTextureId();
 	Gfx->CreateTexture(texId, {AtlasSize, AtlasSize, TF_R}, nullptr);
-	auto space = Memory::BulkGetType<stbrp_node>(RectsCount);
-	stbrp_init_target(&RectContext, AtlasSize, AtlasSize, space,  RectsCount);
+	RectNodes = Memory::BulkGetType<stbrp_node>(RectsCount);
+	stbrp_init_target(&RectContext, AtlasSize, AtlasSize, RectNodes,  RectsCount);
 	Atlases.push_back(texId);
 }
 
@@ -148,12 +148,12 @@ FontLibrary::AtlasEntry FontLibrary::GetEntry(FontId typeFace, char ch)
 	return AtlasGlyphEntries[IdMap.at(typeFace)*Characters.size() + CharMap[ch]];
 }
 
-void FontLibrary::GetEntries(FontId id, const char* text, size_t size, TempVector<AtlasEntry>& vec)
+void FontLibrary::GetEntries(FontId id, const char* text, size_t size, AtlasEntry* entries)
 {
 	size_t typeFace = IdMap.at(id) * Characters.size();
 	for (size_t i = 0; i < size; ++i)
 	{
-		vec.push_back(AtlasGlyphEntries[typeFace + CharMap.at(text[i])]);
+		entries[i] = AtlasGlyphEntries[typeFace + CharMap.at(text[i])];
 	}
 
 }
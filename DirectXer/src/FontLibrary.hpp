@@ -6,6 +6,8 @@
 #include <Graphics.hpp>
 #include <Platform.hpp>
 #include <Containers.hpp>
+#include <FlatMap.hpp>
+#include <ConcurrentMap.hpp>
 
 #include <robin_hood.h>
 #include <stb_rect_pack.h>
@@ -69,9 +71,12 @@ public:
 	Graphics* Gfx;
 	BulkVector<TextureId, Memory_2DRendering> Atlases;
 	stbrp_context RectContext;
+	// @Note: The nodes of the current atlas; the context only points
+	// into them
+	stbrp_node* RectNodes;
 	BulkVector<AtlasEntry, Memory_2DRendering> AtlasGlyphEntries;
-	Map<char, size_t, Memory_2DRendering> CharMap;
-	Map<FontId, size_t, Memory_2DRendering> IdMap;
+	FlatMap<char, size_t, Memory_2DRendering> CharMap;
+	ConcurrentMap<FontId, size_t, Memory_2DRendering> IdMap;
 
 	void Init(Graphics* t_Graphics);
 	void InitNewAtlas();
@@ -81,5 +86,5 @@ public:
 	void CreateMemoryTypeface(FontId id, FontDescription desc, void* data, size_t size);
 	
 	AtlasEntry GetEntry(FontId typeFace, char ch);
-	void GetEntries(FontId id, const char* text, size_t size, TempVector<AtlasEntry>& vec);
+	void GetEntries(FontId id, const char* text, size_t size, AtlasEntry* entries);
 };
@@ -31,7 +31,7 @@ void ExampleScenes::Init()
 
     Renderer2D.InitRenderer(Graphics, { Application->Width, Application->Height });
 
-    Memory::EstablishTempScope(Megabytes(4));
+    Memory::EstablishTempScope();
     {
         AssetBuildingContext masterBuilder{0};
         masterBuilder.ImageLib = &Renderer2D.ImageLib;
@@ -47,7 +47,7 @@ void ExampleScenes::Init()
 
     Renderer3D.InitRenderer(Graphics);
 
-    Memory::EstablishTempScope(Megabytes(4));
+    Memory::EstablishTempScope();
     {
         DebugGeometryBuilder builder;
         builder.Init(8);
@@ -155,22 +155,27 @@ void ExampleScenes::Init()
 
     Renderer3D.InitInstancedDataBuffer(64);
     auto& instData = Renderer3D.AccessInstancedData();
-    for (size_t i = 0; i < 32; i++)
-    {
-        instData[i].model = init_scale(0.5) * init_translate(-4.5f + 1.5f * (8 - (i & 0x0F)), 0.0f, -5.0f + 1.5f * (8 - ((i & 0xF0) >> 4) - 1));
-        instData[i].invModel = glm::inverse(instData[i].model);
-    }
+    // @Note: The second loop reads the models of the first one so they can't be merged
+    ParallelFor(32, 8, [&](size_t t_Begin, size_t t_End) {
+        for (size_t i = t_Begin; i < t_End; i++)
+        {
+            instData[i].model = init_scale(0.5) * init_translate(-4.5f + 1.5f * (8 - (i & 0x0F)), 0.0f, -5.0f + 1.5f * (8 - ((i & 0xF0) >> 4) - 1));
+            instData[i].invModel = glm::inverse(instData[i].model);
+        }
+    });
 
-    for (size_t i = 0; i < 32; i++)
-    {
-        instData[i + 32].model = init_scale(0.07) * init_translate(-4.5f + 1.5f * (8 - (i & 0x0F)), 3.0f, -5.0f + 1.5f * (8 - ((i & 0xF0) >> 4) - 1));
-        instData[i + 32].invModel = glm::inverse(instData[i].model);
-    }
+    ParallelFor(32, 8, [&](size_t t_Begin, size_t t_End) {
+        for (size_t i = t_Begin; i < t_End; i++)
+        {
+            instData[i + 32].model = init_scale(0.07) * init_translate(-4.5f + 1.5f * (8 - (i & 0x0F)), 3.0f, -5.0f + 1.5f * (8 - ((i & 0xF0) >> 4) - 1));
+            instData[i + 32].invModel = glm::inverse(instData[i].model);
+        }
+    });
 
     Renderer3D.UpdateInstancedData();
 
-	MeshStore[0] = {M_TREE_1, Material_001, "Tree"};
-	MeshStore[1] = {M_SUZANNE, SimpleColor, "Monkey"};
+	MeshStore[0] = {M_TREE_1, Material_001, Strings::Intern("Tree")};
+	MeshStore[1] = {M_SUZANNE, SimpleColor, Strings::Intern("Monkey")};
 
 	Meshes.reserve(128);
 	MeshesNames.reserve(128);
@@ -579,10 +584,10 @@ void ExampleScenes::ProcessEditorScene(float dt)
 			{
 				auto mesh = MeshStore[i];
                 if (mesh.Mesh == 0) continue;
-                if (ImGui::Selectable(mesh.Name.data()))
+                if (ImGui::Selectable(Strings::CStr(mesh.Name)))
 				{
                     Meshes.push_back({ mesh.Mesh, mesh.Material, mat4{1}, mesh.Name });
-					MeshesNames.push_back(fmt::format("{}_{}", mesh.Name, Meshes.size()));
+					MeshesNames.push_back(Strings::Intern(Formater.Format("{}_{}", Strings::Get(mesh.Name), Meshes.size())));
 				}
 			}
             ImGui::EndPopup();
@@ -598,7 +603,7 @@ void ExampleScenes::ProcessEditorScene(float dt)
 			for (size_t i = 0; i < Meshes.size(); ++i)
 			{
 				auto mesh = Meshes[i];
-				if (ImGui::Selectable(MeshesNames[i].c_str(), i == SelectedMeshIndex))
+				if (ImGui::Selectable(Strings::CStr(MeshesNames[i]), i == SelectedMeshIndex))
 				{
 					SelectedMesh = mesh.Mesh;
 					SelectedMeshIndex = (uint32)i;
@@ -652,7 +657,7 @@ void ExampleScenes::ProcessEditorScene(float dt)
 
 	Renderer2D.BeginScene();
     Renderer2D.DrawText("Editor Scene", {450.0f, 30.0f}, F_DroidSansBold_24, Color::Chartreuse);
-    Renderer2D.DrawText(Formater.Format("Mesh: {}", MeshesNames[SelectedMeshIndex].c_str()),
+    Renderer2D.DrawText(Formater.Format("Mesh: {}", Strings::CStr(MeshesNames[SelectedMeshIndex])),
 						{450.0f, 57.0f}, F_DroidSansBold_24, Color::Chartreuse);
     Renderer2D.EndScene();
 }
@@ -13,6 +13,7 @@
 #include <Audio.hpp>
 #include <Containers.hpp>
 #include <Serialization.hpp>
+#include <StringInterning.hpp>
 
 enum Scene
 {
@@ -53,7 +54,7 @@ public:
 	{
 		MeshId Mesh;
 		MaterialId Material;
-		String Name;
+		StringId Name;
 	};
 
 	static const inline int MeshPrototypesCount = 3;
@@ -64,13 +65,12 @@ public:
 		MeshId Mesh;
 		MaterialId Material;
 		mat4 Transform;
-		String Name;
+		StringId Name;
 	};
 	
 	TempFormater Formater;
 
-	// @Todo: Replace this with string interning context
-	BulkVector<std::string> MeshesNames;
+	BulkVector<StringId> MeshesNames;
 	BulkVector<MeshEntry> Meshes;
 	MeshId SelectedMesh{0};
 	uint32 SelectedMeshIndex{0};
@@ -5,47 +5,63 @@
 #include <Math.hpp>
 #include <App.hpp>
 #include <Memory.hpp>
+#include <SparseSet.hpp>
 #include <Assets.hpp>
 #include <Timing.hpp>
-
-#include <Timing.hpp>
+#include <TaskGraph.hpp>
 
 #include "SpaceGame.hpp"
 #include <SpaceAssets.hpp>
 
 #include <imgui.h>
 
+#include <immintrin.h>
+#if defined(_WIN32)
+#include <intrin.h>
+#endif
+
 static uint32 EXPLOSION_SPRITE;
 
 static float EXPLOSION_MAX_TIME = 1.0f;
 
-struct Enemy
+// @Note: The fields of the game objects; each one is a column of the
+// sparse set of its kind of object
+enum EnemyField
 {
-	glm::vec2 Position;
-	uint32 Image;
-	bool Dead;
-	float XVector;
+	Enemy_Position,
+	Enemy_Image,
+	Enemy_XVector,
 };
 
-struct Bullet
+enum BulletField
 {
-	glm::vec2 Position;
+	Bullet_Position,
 };
 
-struct Animation
+enum AnimationField
 {
-	uint32 Sheet;
-	glm::vec2 Position;
-	uint32 MaxIndex;
-	uint32 CurrentIndex;
-	float Time;
+	Animation_Sheet,
+	Animation_Position,
+	Animation_MaxIndex,
+	Animation_CurrentIndex,
+	Animation_Time,
 };
 
+using EnemySet = SparseSet<Memory_GameState, glm::vec2, uint32, float>;
+using BulletSet = SparseSet<Memory_GameState, glm::vec2>;
+using AnimationSet = SparseSet<Memory_GameState, uint32, glm::vec2, uint32, uint32, float>;
+
 struct GameState
 {
-	BulkVector<Enemy, Memory_GameState> Enemies;
-	BulkVector<Bullet, Memory_GameState> Bulltets;
-	BulkVector<Animation, Memory_GameState> Animations;
+	// @Note: The objects are packed in the sets; the ones that die during
+	// a frame are put in the dead lists and only those get destroyed in
+	// the cleanup of the next frame
+	EnemySet Enemies;
+	BulletSet Bulltets;
+	AnimationSet Animations;
+	BulkVector<SlotHandle, Memory_GameState> DeadEnemies;
+	BulkVector<SlotHandle, Memory_GameState> DeadBullets;
+	BulkVector<SlotHandle, Memory_GameState> DeadAnimations;
 	uint32 Score;
 	uint32 SpawndedEnemies;
 	glm::vec2 PlayerPosition;
@@ -55,37 +71,106 @@ struct GameState
 	
 };
 
+struct ImageDraw
+{
+	uint32 Image;
+	glm::vec2 Position;
+	glm::vec2 Size;
+};
+
+struct SpriteDraw
+{
+	uint32 Sheet;
+	uint32 Index;
+	glm::vec2 Position;
+};
+
+// @Note: Everything that the rendering needs from the game state; once
+// taken, a snapshot is never written until it is rendered so the
+// rendering never has to look at the game state itself
+struct RenderSnapshot
+{
+	BulkVector<ImageDraw, Memory_GameState> Images;
+	BulkVector<SpriteDraw, Memory_GameState> Sprites;
+	glm::vec2 PlayerPosition;
+	uint32 Score;
+	uint16 Wave;
+	float Time;
+
+	// @Note: The frame of the simulation that the snapshot is of and when
+	// its simulation started; that is how the latency is measured
+	uint64 Frame;
+	uint64 SimulationStart;
+};
+
+static AssetBuildingContext AssetsContext(SpaceGame& t_Game)
+{
+	AssetBuildingContext context{0};
+	context.ImageLib = &t_Game.Renderer2D.ImageLib;
+	context.FontLib = &t_Game.Renderer2D.FontLib;
+	context.WavLib = &t_Game.AudioEngine;
+	context.MeshesLib = nullptr;
+	context.Graphics = t_Game.Graphics;
+	return context;
+}
+
+// @Note: The assets of the game are a level of their own so that they can
+// be reloaded while the game runs (F5) once the asset bundle is rebuilt;
+// the level is the last thing that takes bulk memory
+void SpaceGame::LoadLevel()
+{
+	Memory::EstablishTempScope();
+	AssetBuildingContext masterBuilder = AssetsContext(*this);
+	AssetStore::LoadLevel(Tag_Level, AssetFiles[SpaceGameAssetFile], masterBuilder);
+	AssetStore::SetDebugNames(Graphics, GPUResources, Size(GPUResources));
+	Memory::EndTempScope();
+}
+
+void SpaceGame::ReloadLevel()
+{
+	AssetBuildingContext masterBuilder = AssetsContext(*this);
+	AssetStore::UnloadLevel(Tag_Level, masterBuilder);
+	LoadLevel();
+}
+
 void SpaceGame::Init()
 {
 	DxProfileCode(DxTimedBlock(Phase_Init, "Game initialization"));
 	Renderer2D.InitRenderer(Graphics, { Application->Width, Application->Height });
 
-	Memory::EstablishTempScope(Megabytes(4));
-	AssetBuildingContext masterBuilder{0};
-	masterBuilder.ImageLib = &Renderer2D.ImageLib;
-	masterBuilder.FontLib = &Renderer2D.FontLib;
-	masterBuilder.WavLib = &AudioEngine;
-	masterBuilder.MeshesLib = nullptr;
-	masterBuilder.Graphics = Graphics;
-	
-	AssetStore::LoadAssetFile(AssetFiles[SpaceGameAssetFile], masterBuilder);
-	AssetStore::SetDebugNames(Graphics, GPUResources, Size(GPUResources));
-	Memory::EndTempScope();	
-
 	const uint32 maxSpritesCount = 10;
 	SpriteSheets.Init(maxSpritesCount, &Renderer2D);
-	EXPLOSION_SPRITE = SpriteSheets.PutSheet(I_EXPLOSION, { 960.0f, 384.0f }, { 5, 2 });
 
 	GameState = Memory::BulkGetType<struct GameState>(1, Memory_GameState);
 	GameState->PlayerPosition = { 300.0f, Application->Height - 100.0f };
-	GameState->Enemies.reserve(50);
-	GameState->Bulltets.reserve(100);
+	GameState->Enemies.Init(16);
+	GameState->Bulltets.Init(32);
+	GameState->Animations.Init(16);
+	GameState->DeadEnemies.reserve(16);
+	GameState->DeadBullets.reserve(32);
+	GameState->DeadAnimations.reserve(16);
 	GameState->EnemySpwaner = 0.0f;
 	GameState->SpawndedEnemies = 0;
 	GameState->Time = 0.0f;
 	GameState->Score = 0;
 	GameState->Wave = 1;
 
+	Snapshots = Memory::BulkGetType<RenderSnapshot>(2, Memory_GameState);
+	for (uint32 i = 0; i < 2; ++i)
+	{
+		Snapshots[i].Images.reserve(64);
+		Snapshots[i].Sprites.reserve(16);
+	}
+	RenderedSnapshot = 0;
+	Pipelined = Application->Arguments.Pipelined;
+
+	LoadLevel();
+	EXPLOSION_SPRITE = SpriteSheets.PutSheet(I_EXPLOSION, { 960.0f, 384.0f }, { 5, 2 });
+
+	SimulatedFrames = 0;
+	Snapshots[0].SimulationStart = __rdtsc();
+	TakeSnapshot(Snapshots[0]);
+
 	Graphics->SetRasterizationState(RS_NORMAL);
 }
 
@@ -132,63 +217,125 @@ void SpaceGame::ControlPlayer(float dt)
 
 	if (Input::gInput.IsKeyReleased(KeyCode::Space) || Input::gInput.IsJoystickButtonReleased(GAMEPAD_A))
 	{
-		GameState->Bulltets.push_back({GameState->PlayerPosition + glm::vec2{32.0f, -32.0f}});
+		GameState->Bulltets.Create(GameState->PlayerPosition + glm::vec2{32.0f, -32.0f});
 		AudioEngine.Play(A_SHOOT, 0.25f);
 	}
 }
 
 void SpaceGame::CleanUpDead()
 {
-	auto& bullets = GameState->Bulltets;
-	auto& enemies = GameState->Enemies;
-	auto& animations = GameState->Animations;
-	
-	bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [](auto bullet) { return bullet.Position.y < 0.0f; }), bullets.end());
-	enemies.erase(std::remove_if(enemies.begin(), enemies.end(), [](auto enemy) { return enemy.Dead; }), enemies.end());
+	// @Note: An object can end up in its dead list more than once in a
+	// frame; destroying it the second time does nothing
+	for (auto bullet : GameState->DeadBullets) GameState->Bulltets.Destroy(bullet);
+	for (auto enemy : GameState->DeadEnemies) GameState->Enemies.Destroy(enemy);
+	for (auto animation : GameState->DeadAnimations) GameState->Animations.Destroy(animation);
+
+	GameState->DeadBullets.clear();
+	GameState->DeadEnemies.clear();
+	GameState->DeadAnimations.clear();
+}
 
-	animations.erase(std::remove_if(animations.begin(), animations.end(), [](auto animation) {
-		return animation.Time > EXPLOSION_MAX_TIME;
-	}), animations.end());
+// @Note: The update tasks run at the same time so none of them may grow a
+// container -- that would go to the heap from several threads at once.
+// UpdateGameState makes the room for everything that they add beforehand
+template<class T>
+static void PushReserved(BulkVector<T, Memory_GameState>& t_List, const T& t_Value)
+{
+	Assert(t_List.size() < t_List.capacity(), "A list of the game grew during the parallel update");
+	t_List.push_back(t_Value);
 }
 
-void SpaceGame::UpdateGameState(float dt)
+void SpaceGame::MoveBullets(float dt)
 {
-	OPTICK_EVENT();
-	
-	CleanUpDead();
-	GameState->Time += dt;
-	
+	const float bulletSpeed = 800.0f;
+
 	auto& bullets = GameState->Bulltets;
-	auto& enemies = GameState->Enemies;
+	auto bulletPositions = bullets.Column<Bullet_Position>();
+	for (size_t i = 0; i < bulletPositions.size(); ++i)
+	{
+		bulletPositions[i].y -= bulletSpeed * dt;
+		if (bulletPositions[i].y < 0.0f) PushReserved(GameState->DeadBullets, bullets.Handle(i));
+	}
+}
+
+void SpaceGame::AdvanceAnimations(float dt)
+{
 	auto& animations = GameState->Animations;
+	for (size_t i = 0; i < animations.size(); ++i)
+	{
+		float& time = animations.At<Animation_Time>(i);
+		const uint32 maxIndex = animations.At<Animation_MaxIndex>(i);
+		uint32& currentIndex = animations.At<Animation_CurrentIndex>(i);
+
+		time += 2.5f * dt;
+		currentIndex = uint32(roundf(maxIndex * (time / EXPLOSION_MAX_TIME)));
+		currentIndex = currentIndex >= maxIndex ? maxIndex : currentIndex;
+		if (time > EXPLOSION_MAX_TIME) PushReserved(GameState->DeadAnimations, animations.Handle(i));
+	}
+}
 
-	const float bulletSpeed = 800.0f;
+void SpaceGame::UpdateEnemies(float dt)
+{
 	const float enemySpeed = 80.0f;
+	auto& enemies = GameState->Enemies;
+
+	GameState->EnemySpwaner += dt;
+	if (GameState->EnemySpwaner > Random::Uniform(2.0f, 4.0f) && GameState->SpawndedEnemies < 15)
+	{
+		GameState->SpawndedEnemies += 1;
+		float x = Random::Uniform(50.0f, Application->Width - 50.0f);
+		const float xVector = Random::Uniform(0.0f, 1.0f) < 0.5f ? 50.0f : -50.0f;
+		Assert(enemies.size() < enemies.capacity(), "The enemies grew during the parallel update");
+		enemies.Create(glm::vec2{x, -2.0f}, (uint32)I_EVIL_SHIP_1, xVector);
+		GameState->EnemySpwaner = 0.0f;
+	}
 	
-	for (auto& bullet : GameState->Bulltets)
+	auto enemyPositions = enemies.Column<Enemy_Position>();
+	auto enemyXVectors = enemies.Column<Enemy_XVector>();
+	for(size_t i = 0; i < enemyPositions.size(); ++i)
 	{
-		bullet.Position.y -= bulletSpeed * dt;
+		glm::vec2& position = enemyPositions[i];
+		float& xVector = enemyXVectors[i];
+
+		position.y += enemySpeed * dt;
+		position.x += xVector * dt;
+		if(position.y > Application->Height)
+		{
+			PushReserved(GameState->DeadEnemies, enemies.Handle(i));
+			continue;
+		}
+		
+		if(position.x < 0.0f || position.x > Application->Width - 64.0f)
+		{
+			xVector = -xVector;
+			continue;
+		}
+		
+		xVector = Random::Uniform() < 0.02f ? -xVector : xVector;
 	}
+}
 
-	for (auto& bullet : GameState->Bulltets)
+void SpaceGame::CheckCollisions()
+{
+	auto& bullets = GameState->Bulltets;
+	auto& enemies = GameState->Enemies;
+
+	auto bulletPositions = bullets.Column<Bullet_Position>();
+	auto enemyPositions = enemies.Column<Enemy_Position>();
+	for (size_t i = 0; i < bulletPositions.size(); ++i)
 	{
-		Rectangle2D bulletRect{bullet.Position, { 16.0f, 32.0f }};
+		Rectangle2D bulletRect{bulletPositions[i], { 16.0f, 32.0f }};
 		
-		for (auto& enemy : GameState->Enemies)
+		for (size_t j = 0; j < enemyPositions.size(); ++j)
 		{
-			Rectangle2D enemyRect{enemy.Position, { 64.0f, 64.0f }};
+			Rectangle2D enemyRect{enemyPositions[j], { 64.0f, 64.0f }};
 			
 			if(IntersectRects(bulletRect, enemyRect))
 			{
-				Animation newAnimation;
-				newAnimation.Time = 0.0f;
-				newAnimation.Sheet = EXPLOSION_SPRITE;
-				newAnimation.Position = enemy.Position;
-				newAnimation.MaxIndex = 6;
-				newAnimation.CurrentIndex = 0;
-				GameState->Animations.push_back(newAnimation);
-				enemy.Dead = true;
-				bullet.Position.y = -3.0f;
+				GameState->Animations.Create(EXPLOSION_SPRITE, enemyPositions[j], 6u, 0u, 0.0f);
+				GameState->DeadEnemies.push_back(enemies.Handle(j));
+				GameState->DeadBullets.push_back(bullets.Handle(i));
+				bulletPositions[i].y = -3.0f;
 				AudioEngine.Play(A_EXPLODE, 0.5f);
 				GameState->Score += 1;
 				break;
@@ -197,49 +344,77 @@ void SpaceGame::UpdateGameState(float dt)
 		}
 
 	}
+}
+
+void SpaceGame::UpdateGameState(float dt)
+{
+	OPTICK_EVENT();
+	
+	CleanUpDead();
+	GameState->Time += dt;
+
+	// @Note: The bullets, the animations and the enemies are updated at the
+	// same time; each task writes only to its own set and its own dead list
+	// and the room for what they add (every object dying, one new enemy) is
+	// made here so none of them allocates while the others run. The
+	// collisions need all of them moved (and they start new animations) and
+	// the player can shoot only once the collisions are done with the bullets
+	GameState->DeadBullets.reserve(GameState->Bulltets.size());
+	GameState->DeadAnimations.reserve(GameState->Animations.size());
+	GameState->DeadEnemies.reserve(GameState->Enemies.size() + 1);
+	GameState->Enemies.reserve(GameState->Enemies.size() + 1);
+
+	SpaceGame* game = this;
+	TaskGraph graph;
+	const TaskId bullets = graph.Add("Move bullets", [game, dt]() { game->MoveBullets(dt); });
+	const TaskId animations = graph.Add("Advance animations", [game, dt]() { game->AdvanceAnimations(dt); });
+	const TaskId enemies = graph.Add("Update enemies", [game, dt]() { game->UpdateEnemies(dt); });
+	const TaskId collisions = graph.Add("Check collisions", [game]() { game->CheckCollisions(); });
+	const TaskId player = graph.Add("Control player", [game, dt]() { game->ControlPlayer(dt); });
+
+	graph.Depends(collisions, bullets, animations, enemies);
+	graph.Depends(player, collisions);
+	graph.Run();
+}
+
+void SpaceGame::TakeSnapshot(RenderSnapshot& t_Snapshot)
+{
+	t_Snapshot.Images.clear();
+	t_Snapshot.Sprites.clear();
 
-	for (auto& animation : animations)
+	auto& enemies = GameState->Enemies;
+	for (size_t i = 0; i < enemies.size(); ++i)
 	{
-		animation.Time += 2.5f * dt;
-		animation.CurrentIndex = uint32(roundf(animation.MaxIndex * (animation.Time / EXPLOSION_MAX_TIME)));
-		animation.CurrentIndex = animation.CurrentIndex >= animation.MaxIndex ? animation.MaxIndex : animation.CurrentIndex; 
+		t_Snapshot.Images.push_back({ enemies.At<Enemy_Image>(i), enemies.At<Enemy_Position>(i), { 64.0f, 64.0f } });
 	}
 
-	GameState->EnemySpwaner += dt;
-	if (GameState->EnemySpwaner > Random::Uniform(2.0f, 4.0f) && GameState->SpawndedEnemies < 15)
+	for (const auto& position : GameState->Bulltets.Column<Bullet_Position>())
 	{
-		GameState->SpawndedEnemies += 1;
-		float x = Random::Uniform(50.0f, Application->Width - 50.0f);
-		Enemy newEnemy{{x, -2.0f}, I_EVIL_SHIP_1, false};
-		newEnemy.XVector = Random::Uniform(0.0f, 1.0f) < 0.5f ? 50.0f : -50.0f;
-		GameState->Enemies.push_back(newEnemy);
-		GameState->EnemySpwaner = 0.0f;
+		t_Snapshot.Images.push_back({ (uint32)I_BULLET, position, { 16.0f, 32.0f } });
 	}
-	
-	for(auto& enemy : enemies)
+
+	auto& animations = GameState->Animations;
+	for (size_t i = 0; i < animations.size(); ++i)
 	{
-		enemy.Position.y += enemySpeed * dt;
-		enemy.Position.x += enemy.XVector * dt;
-		if(enemy.Position.y > Application->Height)
-		{
-			enemy.Dead = true;
-			continue;
-		}
-		
-		if(enemy.Position.x < 0.0f || enemy.Position.x > Application->Width - 64.0f)
-		{
-			enemy.XVector = -enemy.XVector;
-			continue;
-		}
-		
-		enemy.XVector = Random::Uniform() < 0.02f ? -enemy.XVector : enemy.XVector;
+		t_Snapshot.Sprites.push_back({ animations.At<Animation_Sheet>(i), animations.At<Animation_CurrentIndex>(i), animations.At<Animation_Position>(i) });
 	}
-	
-	ControlPlayer(dt);
 
+	t_Snapshot.PlayerPosition = GameState->PlayerPosition;
+	t_Snapshot.Score = GameState->Score;
+	t_Snapshot.Wave = GameState->Wave;
+	t_Snapshot.Time = GameState->Time;
+	t_Snapshot.Frame = SimulatedFrames;
 }
 
-void SpaceGame::Render(float dt)
+void SpaceGame::Simulate(float dt, RenderSnapshot& t_Snapshot)
+{
+	t_Snapshot.SimulationStart = __rdtsc();
+	++SimulatedFrames;
+	UpdateGameState(dt);
+	TakeSnapshot(t_Snapshot);
+}
+
+void SpaceGame::Render(const RenderSnapshot& t_Snapshot)
 {
 	OPTICK_EVENT();
 		
@@ -256,42 +431,65 @@ void SpaceGame::Render(float dt)
 	Renderer2D.EndScene();
 
 	Renderer2D.BeginScene();
-	for (const auto& enemy : GameState->Enemies)
+	for (const auto& image : t_Snapshot.Images)
 	{
-		Renderer2D.DrawImage(enemy.Image, enemy.Position, { 64.0f, 64.0f });
+		Renderer2D.DrawImage(image.Image, image.Position, image.Size);
 	}
 
-	for (const auto& bullet : GameState->Bulltets)
+	for (const auto& sprite : t_Snapshot.Sprites)
 	{
-		Renderer2D.DrawImage(I_BULLET, bullet.Position, { 16.0f, 32.0f });
+		SpriteSheets.DrawSprite(sprite.Sheet, sprite.Index, sprite.Position, { 64.0f, 64.0f });
 	}
 
-	for (const auto& anim : GameState->Animations)
-	{
-		SpriteSheets.DrawSprite(anim.Sheet, anim.CurrentIndex, anim.Position, { 64.0f, 64.0f });
-		
-	}
-
-	Renderer2D.DrawImage(I_MAIN_SHIP, GameState->PlayerPosition, { 64.0f, 64.0f });
+	Renderer2D.DrawImage(I_MAIN_SHIP, t_Snapshot.PlayerPosition, { 64.0f, 64.0f });
 	Renderer2D.EndScene();
 	
 	Renderer2D.BeginScene();
 	Renderer2D.DrawImage(I_STATS, {20.0f, 20.0f}, { Application->Width - 40.0f, 32.0f });
 
-	auto time = (int)roundf(GameState->Time);
-	Renderer2D.DrawText(Formater.Format("Wave: {}", GameState->Wave), {42.0f, 44.0f}, F_DroidSansBold_24);
-	Renderer2D.DrawText(Formater.Format("Score: {}", GameState->Score), {260.0f, 44.0f}, F_DroidSansBold_24);
+	auto time = (int)roundf(t_Snapshot.Time);
+	Renderer2D.DrawText(Formater.Format("Wave: {}", t_Snapshot.Wave), {42.0f, 44.0f}, F_DroidSansBold_24);
+	Renderer2D.DrawText(Formater.Format("Score: {}", t_Snapshot.Score), {260.0f, 44.0f}, F_DroidSansBold_24);
 	Renderer2D.DrawText(Formater.Format("Time: {}:{}", time / 60, time % 60), {460.0f, 44.0f}, F_DroidSansBold_24);
 	Renderer2D.DrawImage(I_HEALTH, {10.0f, Application->Height - 32.0f - 20.0f}, { Application->Width / 3.5f, 32.0f});
 	
 	Renderer2D.EndScene();
 }
 
+/*
+  @Note: Without the pipelining, the frame is simulated and then rendered
+  right away. With it, the simulation of the next frame runs as a job
+  while this thread renders the snapshot of the frame before -- the frame
+  costs max(update, render) instead of their sum but what is on the
+  screen is one frame old. The two sides never touch the same snapshot
+  and the rendering never looks at the game state.
+*/
 void SpaceGame::Update(float dt)
 {
 	OPTICK_EVENT();
-	UpdateGameState(dt);
-	// @Note: Main Scene
-	Render(dt);
-}
 
+	if (Input::gInput.IsKeyReleased(KeyCode::F5)) ReloadLevel();
+
+	const RenderSnapshot& rendered = Snapshots[RenderedSnapshot];
+	if (!Pipelined)
+	{
+		Simulate(dt, Snapshots[RenderedSnapshot]);
+		Render(rendered);
+		Telemetry::RecordRenderLatency(SimulatedFrames - rendered.Frame, __rdtsc() - rendered.SimulationStart);
+		return;
+	}
+
+	const uint8 simulated = RenderedSnapshot ^ 1;
+	RenderSnapshot* snapshot = &Snapshots[simulated];
+	SpaceGame* game = this;
+
+	JobCounter simulation;
+	JobSystem::Run(simulation, [game, dt, snapshot]() { game->Simulate(dt, *snapshot); });
+	Render(rendered);
+	const uint64 renderEnd = __rdtsc();
+	JobSystem::Wait(simulation);
+
+	// @Note: The counter of the simulated frames can be read only once the simulation is done
+	Telemetry::RecordRenderLatency(SimulatedFrames - rendered.Frame, renderEnd - rendered.SimulationStart);
+	RenderedSnapshot = simulated;
+}
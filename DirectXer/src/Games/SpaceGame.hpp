@@ -15,6 +15,7 @@
 
 class App;
 struct GameState;
+struct RenderSnapshot;
 class SpaceGame
 {
 public:
@@ -23,6 +24,9 @@ public:
 	void Update(float dt);
 	void Resize();
 
+	void LoadLevel();
+	void ReloadLevel();
+
 	Graphics* Graphics;
 	App* Application;
 	
@@ -35,9 +39,25 @@ public:
 
 	GameState* GameState;
 
+	// @Note: Two snapshots of what is on the screen; in the pipelined mode
+	// the simulation fills one of them while the other one is rendered
+	RenderSnapshot* Snapshots;
+	uint8 RenderedSnapshot;
+	bool Pipelined;
+	uint64 SimulatedFrames;
+
 	// @Note: These will be used only by the concreate game
 	void UpdateGameState(float dt);
-	void Render(float dt);
+	void TakeSnapshot(RenderSnapshot& t_Snapshot);
+	void Simulate(float dt, RenderSnapshot& t_Snapshot);
+	void Render(const RenderSnapshot& t_Snapshot);
 	void ControlPlayer(float dt);
 	void CleanUpDead();
+
+	// @Note: The tasks of the update; see UpdateGameState for how they
+	// depend on each other
+	void MoveBullets(float dt);
+	void AdvanceAnimations(float dt);
+	void UpdateEnemies(float dt);
+	void CheckCollisions();
 };
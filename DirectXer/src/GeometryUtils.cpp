@@ -167,7 +167,7 @@ static void SetColor(TempVector<ColorVertex>& t_Vertices, const GeometryInfo& t_
 	
 IndexedGPUBuffer DebugGeometryBuilder::CreateBuffer(Graphics* graphics)
 {
-	Memory::EstablishTempScope(Megabytes(4));
+	Memory::EstablishTempScope();
 
 	// @Note: This will be the sentinel element at the end of the blob
 	BlobArena.Put(GT_UNKNOWN);
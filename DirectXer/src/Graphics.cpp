@@ -9,30 +9,47 @@ void DrawFullscreenQuad(Graphics* Graphics, TextureId texture, ShaderConfigurati
 	Graphics->Draw(TT_TRIANGLE_STRIP, 4, 0);
 }
 
+static GPUHandlePool TextureHandles{};
+static GPUHandlePool ConstantBufferHandles{};
+static GPUHandlePool IndexBufferHandles{};
+static GPUHandlePool VertexBufferHandles{};
+
 TextureId NextTextureId()
 {
-	static TextureId next = 0;
-	++next;
-	return next;
+	return TextureHandles.Acquire();
 }
 
 ConstantBufferId NextConstantBufferId()
 {
-	static ConstantBufferId next = 0;
-	++next;
-	return next;
+	return ConstantBufferHandles.Acquire();
 }
 
 IndexBufferId NextIndexBufferId()
 {
-	static IndexBufferId next = 0;
-	++next;
-	return next;
+	return IndexBufferHandles.Acquire();
 }
 
 VertexBufferId NextVertexBufferId()
 {
-	static IndexBufferId next = 0;
-	++next;
-	return next;
+	return VertexBufferHandles.Acquire();
+}
+
+void ReleaseTextureId(TextureId t_Id)
+{
+	TextureHandles.Release(t_Id);
+}
+
+void ReleaseConstantBufferId(ConstantBufferId t_Id)
+{
+	ConstantBufferHandles.Release(t_Id);
+}
+
+void ReleaseIndexBufferId(IndexBufferId t_Id)
+{
+	IndexBufferHandles.Release(t_Id);
+}
+
+void ReleaseVertexBufferId(VertexBufferId t_Id)
+{
+	VertexBufferHandles.Release(t_Id);
 }
@@ -22,8 +22,3 @@ IndexBufferId indexBufferFactory(IndexBufferId id, Graphics& graphics, TempVecto
 }
 
 void DrawFullscreenQuad(Graphics* Graphics, TextureId texture, ShaderConfiguration type);
-
-TextureId NextTextureId();
-ConstantBufferId NextConstantBufferId();
-IndexBufferId NextIndexBufferId();
-VertexBufferId NextVertexBufferId();
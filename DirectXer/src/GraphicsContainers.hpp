@@ -3,83 +3,154 @@
 #include <Containers.hpp>
 #include <Timing.hpp>
 
-template<class Key, class Value, SystemTag Tag>
-struct SimdFlatMap
+/*
+  @Note: The ids of the GPU resources are 16 bit handles. The ones with
+  the top bit set are given out by the asset builder and are fixed; the
+  rest are runtime handles made of a slot index and a generation. The
+  generation of a slot is bumped every time the handle is given back so
+  an old handle to a reused slot can be told apart from the new one.
+*/
+struct GPUHandle
 {
-	using Node = std::pair<uint16, Value>;
-	BulkVector<Node, Memory_GPUResource> Nodes;
+	inline static const uint16 AssetBit = 1u << 15;
+	inline static const uint16 IndexBits = 11;
+	inline static const uint16 IndexMask = (1u << IndexBits) - 1;
+	inline static const uint16 GenerationMask = (AssetBit - 1) >> IndexBits;
+	inline static const uint16 MaxRuntimeHandles = 1u << IndexBits;
 
-	void reserve(size_t size)
+	static bool IsAsset(uint16 t_Handle)
 	{
-		Nodes.reserve(size);
+		return (t_Handle & AssetBit) != 0;
 	}
-	
-	std::pair<bool, bool> insert(Node node)
+
+	static uint16 Index(uint16 t_Handle)
 	{
-		Nodes.push_back(node);
-		return { true, true };
+		return IsAsset(t_Handle) ? uint16(t_Handle & ~AssetBit) : uint16(t_Handle & IndexMask);
 	}
+};
+
+// @Note: Gives out the runtime handles for one kind of GPU resource; the
+// slots of the destroyed resources are reused through the free list.
+// Slot 0 is never used so that 0 can stay the "no resource" handle
+struct GPUHandlePool
+{
+	uint8 Generations[GPUHandle::MaxRuntimeHandles];
+	uint16 FreeList[GPUHandle::MaxRuntimeHandles];
+	uint16 FreeCount;
+	uint16 NextIndex;
 
-	auto value_at(uint32 id)
+	uint16 Acquire()
 	{
-		DxCycleBlock(Tag, CC_SimdFlatMap_At);
-		auto current = Nodes.data();
-		
-		__m128i value = _mm_set1_epi16(id);
-		
-		for (size_t i = 0; i < Nodes.size(); i += 8, current += 8)
+		uint16 index;
+		if (FreeCount > 0)
 		{
-			__m128i keys = _mm_set_epi16(current[7].first, current[6].first, current[5].first, current[4].first,
-										 current[3].first, current[2].first, current[1].first, current[0].first);
-			__m128i result = _mm_cmpeq_epi16(keys, value);
-			unsigned long mask = (unsigned long) _mm_movemask_epi8(result);
-			unsigned long index;
-			_BitScanForward(&index, mask);
-
-			if(mask)
-			{
-				return Nodes.begin() + i + (index >> 1);
-			}
+			index = FreeList[--FreeCount];
 		}
-		
-		return Nodes.end();
+		else
+		{
+			index = NextIndex == 0 ? 1 : NextIndex;
+			Assert(index < GPUHandle::MaxRuntimeHandles, "Too many GPU resources of one kind are alive: {}", index);
+			NextIndex = index + 1;
+		}
+
+		return uint16(Generations[index] << GPUHandle::IndexBits | index);
 	}
 
-	Value& at(uint32 id)
+	void Release(uint16 t_Handle)
 	{
-		auto it = value_at(id);
-		Assert(it != Nodes.end(), "Can't find element in has table.");
-		return it->second;
+		// @Note: The asset handles are fixed; the asset loading creates
+		// the same ones again
+		if (GPUHandle::IsAsset(t_Handle)) return;
+
+		const uint16 index = GPUHandle::Index(t_Handle);
+		Generations[index] = (Generations[index] + 1) & GPUHandle::GenerationMask;
+		FreeList[FreeCount++] = index;
 	}
+};
 
-	Value erase_at(uint32 id)
+// @Note: The pools of the four resource kinds live in Graphics.cpp; the
+// graphics backends give the handles back when they destroy a resource
+TextureId NextTextureId();
+ConstantBufferId NextConstantBufferId();
+IndexBufferId NextIndexBufferId();
+VertexBufferId NextVertexBufferId();
+
+void ReleaseTextureId(TextureId t_Id);
+void ReleaseConstantBufferId(ConstantBufferId t_Id);
+void ReleaseIndexBufferId(IndexBufferId t_Id);
+void ReleaseVertexBufferId(VertexBufferId t_Id);
+
+/*
+  @Note: The GPU resources indexed directly by the slot of their
+  handle; resolving and destroying are both O(1). The runtime and the
+  asset handles have separate slot arrays that grow as needed. Only the
+  debug builds keep the full handle in the slot to catch stale handles.
+*/
+template<class Key, class Value, SystemTag Tag>
+struct GPUSlotMap
+{
+	using Node = std::pair<uint16, Value>;
+
+	struct Slot
 	{
-		auto it = value_at(id);
-		Value res = it->second;
-		Nodes.erase(it);
-		return res;
+		Value Object;
+#ifdef _DEBUG
+		uint16 Handle;
+#endif
+		bool Alive;
+	};
+
+	BulkVector<Slot, Memory_GPUResource> RuntimeSlots;
+	BulkVector<Slot, Memory_GPUResource> AssetSlots;
+
+	BulkVector<Slot, Memory_GPUResource>& SlotsOf(uint16 id)
+	{
+		return GPUHandle::IsAsset(id) ? AssetSlots : RuntimeSlots;
 	}
 
-	auto begin()
+	void reserve(size_t size)
 	{
-		return Nodes.begin();
+		RuntimeSlots.reserve(size);
+		AssetSlots.reserve(size);
 	}
 
-	auto end()
+	std::pair<bool, bool> insert(Node node)
 	{
-		return Nodes.end();
+		auto& slots = SlotsOf(node.first);
+		const uint16 index = GPUHandle::Index(node.first);
+		if (index >= slots.size()) slots.resize(index + 1);
+
+		auto& slot = slots[index];
+		if (slot.Alive) return { false, false };
+
+		slot.Object = node.second;
+#ifdef _DEBUG
+		slot.Handle = node.first;
+#endif
+		slot.Alive = true;
+		return { true, true };
 	}
-	
-	const auto begin() const
+
+	Value& at(uint32 id)
 	{
-		return Nodes.begin();
+		DxCycleBlock(Tag, CC_GPUSlotMap_At);
+		auto& slot = SlotsOf((uint16)id)[GPUHandle::Index((uint16)id)];
+#ifdef _DEBUG
+		Assert(slot.Alive && slot.Handle == id, "Usage of a destroyed or stale GPU resource: {}", id);
+#endif
+		return slot.Object;
 	}
 
-	const auto end() const
+	Value erase_at(uint32 id)
 	{
-		return Nodes.end();
-	}			
+		auto& slot = SlotsOf((uint16)id)[GPUHandle::Index((uint16)id)];
+#ifdef _DEBUG
+		Assert(slot.Alive && slot.Handle == id, "Destroying a destroyed or stale GPU resource: {}", id);
+#endif
+		slot.Alive = false;
+		return slot.Object;
+	}
 };
 
 template<class Key, class Value, SystemTag Tag>
-using GPUResourceMap = SimdFlatMap<Key, Value, Tag>;
+using GPUResourceMap = GPUSlotMap<Key, Value, Tag>;
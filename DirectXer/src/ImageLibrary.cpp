@@ -28,13 +28,17 @@ void ImageLibraryBuilder::PutImage(std::string_view t_Path, uint32 t_Id)
 void ImageLibrary::Init(Graphics* Gfx)
 {
 	this->Gfx = Gfx;
-	InitAtlas();
+
+	// @Note: The contexts point into themselves so the atlases can't
+	// move once they are there
 	Atlases.reserve(MaxAtlases);
+	for (auto& nodes : RectNodes) nodes = nullptr;
+	InitAtlas();
 }
 
 ImageAtlas ImageLibrary::InitAtlas()
 {
-	Assert(Atlases.size() <= MaxAtlases, "Too many image atlases. Try increasing the maximum atlases number");
+	Assert(Atlases.size() < MaxAtlases, "Too many image atlases. Try increasing the maximum atlases number");
 
 	ImageAtlas newAtlas;
 	newAtlas.TexHandle = NextTextureId();
@@ -44,6 +48,7 @@ ImageAtlas ImageLibrary::InitAtlas()
 	// @Note: 8Kb Per atlas for tect packing; maybe we can bump this to 16KB for best rect packing results
 	auto space = Memory::BulkGetType<stbrp_node>(RectsCount);
 	stbrp_init_target(&Atlases.back().RectContext, ImageAtlasSize, ImageAtlasSize, space, RectsCount);
+	RectNodes[Atlases.size() - 1] = space;
 
 	return Atlases.back();
 }
@@ -66,7 +71,7 @@ TextureId ImageLibrary::Pack(stbrp_rect& t_Rect)
 void ImageLibrary::Build(ImageLibraryBuilder& t_Builder)
 {
 	MemoryArena fileArena = Memory::GetTempArena(t_Builder.MaxFileSize + Megabytes(1));
-	Memory::EstablishTempScope(Megabytes(64));
+	Memory::EstablishTempScope();
 	Defer { 
 		Memory::EndTempScope();
 		Memory::DestoryTempArena(fileArena);
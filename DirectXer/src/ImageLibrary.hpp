@@ -7,6 +7,7 @@
 #include <Graphics.hpp>
 #include <Platform.hpp>
 #include <Containers.hpp>
+#include <ConcurrentMap.hpp>
 #include <Tags.hpp>
 
 #include <stb_rect_pack.h>
@@ -64,8 +65,12 @@ class ImageLibrary
 {
   public:
 	Graphics* Gfx;
-	Map<ImageId, Image, Memory_2DRendering> Images;
+	ConcurrentMap<ImageId, Image, Memory_2DRendering> Images;
 	BulkVector<ImageAtlas, Memory_2DRendering> Atlases;
+	// @Note: The nodes of the atlases that images get packed in; the
+	// contexts only point into them. The atlases from the asset files are
+	// already packed and have none
+	stbrp_node* RectNodes[MaxAtlases];
 
 	void Init(Graphics* Gfx);
 	TextureId Pack(stbrp_rect& t_Rect);
@@ -0,0 +1,237 @@
+#include <Jobs.hpp>
+#include <Logging.hpp>
+
+#include <chrono>
+#include <cstring>
+
+JobSystemState JobSystem::g_Jobs{};
+thread_local JobWorker* JobSystem::g_Worker{nullptr};
+
+// @Note: How many times an idle worker looks for jobs before going to sleep
+static const uint32 IdleSpins = 64;
+
+void JobDeque::Init(size_t t_Capacity)
+{
+	Items = (std::atomic<Job*>*)Memory::BulkGet(t_Capacity * sizeof(std::atomic<Job*>), Memory_Jobs, CacheLineSize);
+	for (size_t i = 0; i < t_Capacity; ++i) new (&Items[i]) std::atomic<Job*>(nullptr);
+	Mask = (int64)t_Capacity - 1;
+	Top.store(0, std::memory_order_relaxed);
+	Bottom.store(0, std::memory_order_relaxed);
+}
+
+bool JobDeque::Push(Job* t_Job)
+{
+	const int64 bottom = Bottom.load(std::memory_order_relaxed);
+	const int64 top = Top.load(std::memory_order_acquire);
+	if (bottom - top > Mask) return false;
+
+	Items[bottom & Mask].store(t_Job, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	Bottom.store(bottom + 1, std::memory_order_relaxed);
+	return true;
+}
+
+Job* JobDeque::Pop()
+{
+	const int64 bottom = Bottom.load(std::memory_order_relaxed) - 1;
+	Bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64 top = Top.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		Bottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = Items[bottom & Mask].load(std::memory_order_relaxed);
+	if (top == bottom)
+	{
+		// @Note: The last job; a thief may be after it as well
+		if (!Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) job = nullptr;
+		Bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+Job* JobDeque::Steal()
+{
+	int64 top = Top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const int64 bottom = Bottom.load(std::memory_order_acquire);
+	if (top >= bottom) return nullptr;
+
+	Job* job = Items[top & Mask].load(std::memory_order_relaxed);
+	if (!Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+	return job;
+}
+
+static void InitWorker(JobWorker& t_Worker, uint32 t_Index)
+{
+	t_Worker.Deque.Init(JobSystem::JobsPerWorker);
+	t_Worker.Jobs = Memory::BulkGetType<Job>(JobSystem::JobsPerWorker, Memory_Jobs);
+	for (uint32 i = 0; i < JobSystem::JobsPerWorker; ++i) new (&t_Worker.Jobs[i].Function) std::atomic<JobFunction>(nullptr);
+	t_Worker.NextJob = 0;
+	t_Worker.Index = t_Index;
+	t_Worker.Random = 0x9E3779B9u * (t_Index + 1);
+}
+
+static void WorkerLoop(JobWorker* t_Worker)
+{
+	Memory::InitThreadTempMemory();
+	JobSystem::g_Worker = t_Worker;
+
+	auto& jobs = JobSystem::g_Jobs;
+	uint32 idle = 0;
+	while (jobs.Running.load(std::memory_order_acquire))
+	{
+		if (JobSystem::RunOne())
+		{
+			idle = 0;
+			continue;
+		}
+
+		if (++idle < IdleSpins)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		// @Note: The timeout covers a job that was started right before
+		// the worker went to sleep
+		std::unique_lock<std::mutex> lock(jobs.SleepMutex);
+		jobs.Sleeping.fetch_add(1, std::memory_order_relaxed);
+		jobs.SleepCondition.wait_for(lock, std::chrono::milliseconds(1));
+		jobs.Sleeping.fetch_sub(1, std::memory_order_relaxed);
+		idle = 0;
+	}
+
+	JobSystem::g_Worker = nullptr;
+	Memory::ReleaseThreadTempMemory();
+}
+
+void JobSystem::Init(uint32 t_Workers)
+{
+	Assert(!g_Jobs.Workers, "The job system is already initialized");
+
+	if (t_Workers == 0)
+	{
+		const uint32 cores = std::thread::hardware_concurrency();
+		t_Workers = cores > 1 ? cores - 1 : 0;
+	}
+	t_Workers = t_Workers > MaxWorkers ? MaxWorkers : t_Workers;
+
+	g_Jobs.WorkersCount = t_Workers + 1;
+	g_Jobs.Workers = Memory::BulkGetType<JobWorker>(g_Jobs.WorkersCount, Memory_Jobs);
+	g_Jobs.Threads = Memory::BulkGetType<std::thread>(g_Jobs.WorkersCount, Memory_Jobs);
+	g_Jobs.Sleeping.store(0, std::memory_order_relaxed);
+	g_Jobs.Running.store(true, std::memory_order_release);
+
+	for (uint32 i = 0; i < g_Jobs.WorkersCount; ++i)
+	{
+		new (&g_Jobs.Workers[i]) JobWorker();
+		InitWorker(g_Jobs.Workers[i], i);
+	}
+	g_Worker = &g_Jobs.Workers[0];
+
+	for (uint32 i = 1; i < g_Jobs.WorkersCount; ++i)
+	{
+		new (&g_Jobs.Threads[i]) std::thread(WorkerLoop, &g_Jobs.Workers[i]);
+	}
+
+	DXDEBUG("[Init] Job system with {} worker threads", t_Workers);
+}
+
+void JobSystem::Shutdown()
+{
+	if (!g_Jobs.Workers) return;
+
+	g_Jobs.Running.store(false, std::memory_order_release);
+	g_Jobs.SleepCondition.notify_all();
+	for (uint32 i = 1; i < g_Jobs.WorkersCount; ++i)
+	{
+		g_Jobs.Threads[i].join();
+		g_Jobs.Threads[i].~thread();
+	}
+
+	g_Worker = nullptr;
+	g_Jobs.Workers = nullptr;
+	g_Jobs.WorkersCount = 0;
+}
+
+void JobSystem::Run(JobCounter& t_Counter, JobFunction t_Function, const void* t_Data, size_t t_Size)
+{
+	JobWorker* worker = g_Worker;
+	Assert(worker, "Only the threads of the job system can start jobs");
+	Assert(t_Size <= Job::DataSize, "The data of the job does not fit in it: {}", t_Size);
+
+	// @Note: The next slot of the ring can still be in use if this worker
+	// started a lot of jobs without waiting for them; the job then runs
+	// right here which also does the work that is holding everything up.
+	// The same goes for a full deque
+	Job* job = &worker->Jobs[worker->NextJob & (JobsPerWorker - 1)];
+	if (!job->Function.load(std::memory_order_acquire))
+	{
+		job->Counter = &t_Counter;
+		if (t_Size) std::memcpy(job->Data, t_Data, t_Size);
+		job->Function.store(t_Function, std::memory_order_relaxed);
+
+		t_Counter.Pending.fetch_add(1, std::memory_order_relaxed);
+		if (worker->Deque.Push(job))
+		{
+			++worker->NextJob;
+			if (g_Jobs.Sleeping.load(std::memory_order_relaxed) > 0) g_Jobs.SleepCondition.notify_one();
+			return;
+		}
+
+		t_Counter.Pending.fetch_sub(1, std::memory_order_relaxed);
+		job->Function.store(nullptr, std::memory_order_relaxed);
+	}
+
+	alignas(CacheLineSize) char data[Job::DataSize];
+	if (t_Size) std::memcpy(data, t_Data, t_Size);
+	t_Function(data);
+}
+
+bool JobSystem::RunOne()
+{
+	JobWorker* worker = g_Worker;
+	Job* job = worker->Deque.Pop();
+
+	// @Note: Nothing of our own; try the other workers starting from a
+	// random one so that the thieves spread out
+	if (!job)
+	{
+		uint32 random = worker->Random;
+		random ^= random << 13;
+		random ^= random >> 17;
+		random ^= random << 5;
+		worker->Random = random;
+
+		const uint32 count = g_Jobs.WorkersCount;
+		for (uint32 i = 0; i < count && !job; ++i)
+		{
+			const uint32 victim = (random + i) % count;
+			if (victim != worker->Index) job = g_Jobs.Workers[victim].Deque.Steal();
+		}
+	}
+
+	if (!job) return false;
+
+	// @Note: The owner may take the slot as soon as the function is
+	// cleared so the counter is read before that
+	JobCounter* counter = job->Counter;
+	job->Function.load(std::memory_order_relaxed)(job->Data);
+	job->Function.store(nullptr, std::memory_order_release);
+	counter->Pending.fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+void JobSystem::Wait(JobCounter& t_Counter)
+{
+	Assert(g_Worker, "Only the threads of the job system can wait for jobs");
+	while (!t_Counter.Done())
+	{
+		if (!RunOne()) std::this_thread::yield();
+	}
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Utils.hpp>
+#include <Tags.hpp>
+#include <Config.hpp>
+#include <Memory.hpp>
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
+
+using JobFunction = void(*)(void* t_Data);
+
+// @Note: Counts the jobs that still have to finish; every job that is
+// started with a counter adds one to it and takes it away once done
+struct JobCounter
+{
+	std::atomic<uint32> Pending{0};
+
+	bool Done() const { return Pending.load(std::memory_order_acquire) == 0; }
+};
+
+// @Note: The data of the job is copied into it so that the caller does
+// not have to keep it alive; a job is exactly one cache line. The function
+// is cleared once the job has run, that is how its owner knows that the
+// slot can be taken again
+struct alignas(CacheLineSize) Job
+{
+	inline static const size_t DataSize = CacheLineSize - sizeof(std::atomic<JobFunction>) - sizeof(JobCounter*);
+
+	std::atomic<JobFunction> Function;
+	JobCounter* Counter;
+	char Data[DataSize];
+};
+
+/*
+  @Note: Chase-Lev work-stealing deque. The worker that owns it pushes and
+  pops at the bottom, the other workers steal from the top; only the last
+  job in the deque is ever contended for, and then it takes a single CAS.
+  The deque is bounded; Push returns false when it is full.
+*/
+struct JobDeque
+{
+	alignas(CacheLineSize) std::atomic<int64> Top;
+	alignas(CacheLineSize) std::atomic<int64> Bottom;
+	alignas(CacheLineSize) std::atomic<Job*>* Items;
+	int64 Mask;
+
+	void Init(size_t t_Capacity);
+	bool Push(Job* t_Job);
+	Job* Pop();
+	Job* Steal();
+};
+
+// @Note: Everything a thread of the job system owns; the main thread is
+// worker 0
+struct alignas(CacheLineSize) JobWorker
+{
+	JobDeque Deque;
+	// @Note: The jobs of the worker are taken from the ring in order; a
+	// slot whose old job has not run yet is not taken again (see Run)
+	Job* Jobs;
+	uint32 NextJob;
+	uint32 Index;
+	uint32 Random;
+};
+
+struct JobSystemState
+{
+	JobWorker* Workers;
+	std::thread* Threads;
+	uint32 WorkersCount;
+	std::atomic<bool> Running;
+
+	// @Note: Idle workers sleep until somebody starts a job
+	std::atomic<uint32> Sleeping;
+	std::mutex SleepMutex;
+	std::condition_variable SleepCondition;
+};
+
+/*
+  @Note: Work-stealing job system. Every worker thread has its own deque
+  and runs the jobs from it; a worker without jobs steals from the other
+  ones. The jobs live in per-worker rings taken from the bulk memory at
+  init so starting a job never allocates.
+
+  A worker that starts more jobs than its ring and deque can hold runs the
+  extra ones right away on its own thread instead of queueing them.
+
+  Wait() does not block the thread -- it runs jobs until the counter gets
+  to zero, so the main thread (and any job) can wait on jobs that it has
+  started without wasting a core.
+*/
+struct JobSystem
+{
+	inline static const uint32 JobsPerWorker = 4096;
+	// @Note: Every worker takes one of the thread slots of the temporary
+	// memory; one slot is left for the other threads of the engine
+	inline static const uint32 MaxWorkers = Memory::MaxTempThreads - 1;
+
+	static JobSystemState g_Jobs;
+	static thread_local JobWorker* g_Worker;
+
+	// @Note: Zero workers means one per core besides the main thread
+	static void Init(uint32 t_Workers = 0);
+	static void Shutdown();
+
+	// @Note: Threads that run jobs, the main thread included
+	static uint32 ThreadsCount() { return g_Jobs.WorkersCount; }
+
+	static void Run(JobCounter& t_Counter, JobFunction t_Function, const void* t_Data = nullptr, size_t t_Size = 0);
+
+	template<class Function>
+	static void Run(JobCounter& t_Counter, const Function& t_Function)
+	{
+		static_assert(sizeof(Function) <= Job::DataSize, "The captures of the job don't fit in it");
+		static_assert(std::is_trivially_copyable_v<Function>, "The captures of the job must be trivially copyable");
+		Run(t_Counter, [](void* t_Data) { (*(Function*)t_Data)(); }, &t_Function, sizeof(Function));
+	}
+
+	static void Wait(JobCounter& t_Counter);
+
+	// @Note: Runs one job if there is any; false if there was none
+	static bool RunOne();
+};
@@ -5,6 +5,7 @@
 #include <Logging.hpp>
 #include <Audio.hpp>
 #include <Timing.hpp>
+#include <Jobs.hpp>
 
 static void ParseCommandLineArguments(CommandLineSettings& t_Settings, char** argv, int argc)
 {
@@ -15,8 +16,70 @@ static void ParseCommandLineArguments(CommandLineSettings& t_Settings, char** ar
 			DXDEBUG("[Init] Argument: {} -> {}", argv[i], argv[i + 1]);
 			t_Settings.ResourcesPath = argv[i + 1];
 			++i;
-		}		
+		}
+		else if (strcmp(argv[i], "--pipelined") == 0)
+		{
+			DXDEBUG("[Init] Argument: {}", argv[i]);
+			t_Settings.Pipelined = true;
+		}
+	}
+}
+
+// @Note: The budget names are the names of the memory tags without the
+// " Memory" at the end; e.g. "--budget Audio 16" gives the audio 16MBs.
+// The memory tags are the last ones before Tag_Unknown; the bulk memory
+// itself can't have a budget
+static SystemTag FindMemoryTag(const char* t_Name)
+{
+	const size_t length = strlen(t_Name);
+	for (uint32 tag = Memory_GameState; tag < Tag_Unknown; ++tag)
+	{
+		if (strncmp(gSystemTagNames[tag], t_Name, length) == 0 && strcmp(gSystemTagNames[tag] + length, " Memory") == 0)
+		{
+			return (SystemTag)tag;
+		}
+	}
+	return Tag_Unknown;
+}
+
+// @Note: The memory is set up before the application object (and its
+// settings) exist so the memory arguments are parsed on their own
+static void ParseMemoryArguments(MemorySettings& t_Settings, char** argv, int argc)
+{
+	for (size_t i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--huge-pages") == 0)
+		{
+			t_Settings.HugePages = true;
+		}
+		else if (strcmp(argv[i], "--budget") == 0 && i + 2 < argc)
+		{
+			const SystemTag tag = FindMemoryTag(argv[i + 1]);
+			if (tag == Tag_Unknown)
+			{
+				DXLOG("[Init] Unknown memory budget: {}", argv[i + 1]);
+			}
+			else
+			{
+				t_Settings.Budgets[tag] = Megabytes(strtoull(argv[i + 2], nullptr, 10));
+			}
+			i += 2;
+		}
+	}
+}
+
+// @Note: "--workers N" sets the number of worker threads of the job
+// system; without it there is one worker per core besides the main thread
+static uint32 ParseWorkersArgument(char** argv, int argc)
+{
+	for (size_t i = 1; i + 1 < argc; ++i)
+	{
+		if (strcmp(argv[i], "--workers") == 0)
+		{
+			return (uint32)strtoul(argv[i + 1], nullptr, 10);
+		}
 	}
+	return 0;
 }
 
 // @Note: This is not the true main funtion; this will be called from the platform
@@ -28,8 +91,11 @@ App* InitMain(char** argv, int argc)
 
     // @Note: Initalize every subsystem here
     Input::Init();
-    Memory::InitMemoryState();
     PlatformLayer::Init();
+    MemorySettings memorySettings{0};
+    ParseMemoryArguments(memorySettings, argv, argc);
+    Memory::InitMemoryState(memorySettings);
+    JobSystem::Init(ParseWorkersArgument(argv, argc));
     Random::Init();
     Audio::Init();
 
@@ -219,14 +219,14 @@ MtlMaterial& MaterialLibrary::GetMtl(MaterialId id)
 static bool ChooseTexture(Graphics* graphics, TextureCatalog& catalog, const char* title, TextureId& texId)
 {
 	auto it = std::find_if(catalog.LoadedTextures.begin(), catalog.LoadedTextures.end(), [&texId](auto& t) { return t.Handle == texId; });
-	auto texName = it != catalog.LoadedTextures.end() ? it->Name.data() : "NotSelected";
+	auto texName = it != catalog.LoadedTextures.end() ? Strings::CStr(it->Name) : "NotSelected";
 	bool changed = false;
 	if (ImGui::BeginCombo(title, texName))
 	{
 		for (int i = 0; i < (int)catalog.LoadedTextures.size(); ++i)
 		{
 			auto& tex = catalog.LoadedTextures[i];
-			if (ImGui::Selectable(tex.Name.data(), tex.Handle == texId))
+			if (ImGui::Selectable(Strings::CStr(tex.Name), tex.Handle == texId))
 			{
 				texId = tex.Handle;
 				changed = true;
@@ -3,6 +3,7 @@
 #include <Graphics.hpp>
 #include <GraphicsCommon.hpp>
 #include <Glm.hpp>
+#include <FlatMap.hpp>
 
 /*
    @Note: "Material" is nothing more than a shader and some data
@@ -165,7 +166,7 @@ class MaterialLibrary
 	BulkVector<TexturedMaterial> TexMaterials;
 
 	Map<MaterialId, MaterialUpdateProxy> UpdateViews;
-	Map<MaterialId, MaterialBindProxy> BindViews;
+	FlatMap<MaterialId, MaterialBindProxy> BindViews;
 
   public:
 
@@ -2,6 +2,7 @@
 
 #include <Glm.hpp>
 #include <GraphicsCommon.hpp>
+#include <Parallel.hpp>
 
 #include <cmath>
 #include <utility>
@@ -17,14 +18,18 @@ inline constexpr float PI = 3.14159265358979323846f;
 
 // @Note: Transfrom some vertecies with a given transform matrix; this
 // can potentially be epxesinve operation but it is meant to be used
-// only on startup or to precompute something
+// only on startup or to precompute something. Big meshes are split
+// between the threads of the job system, the small ones stay inline
 template<typename T>
 static void TransformVertices(glm::mat4 t_Mat, T* t_Vertices, size_t t_Count)
 {
-	for (size_t i = 0; i < t_Count; ++i)
-	{
-		TransformVertex(*t_Vertices++, t_Mat);
-	}
+	const size_t grain = 4096;
+	ParallelFor(t_Count, grain, [t_Mat, t_Vertices](size_t t_Begin, size_t t_End) {
+		for (size_t i = t_Begin; i < t_End; ++i)
+		{
+			TransformVertex(t_Vertices[i], t_Mat);
+		}
+	});
 }
 
 struct Rectangle2D
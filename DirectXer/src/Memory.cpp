@@ -4,20 +4,33 @@
 #include <Tags.hpp>
 
 
-const size_t Memory::TempMemoryRequired = Megabytes(256);
-const size_t Memory::BulkMemoryRequired = Megabytes(128);
-const size_t Memory::TotalMemoryRequired = TempMemoryRequired + BulkMemoryRequired;
+// @Note: Those are only reserved; the pages are committed when the
+// memory actually gets used so on 64 bit we can afford to be generous
+static const bool Is64Bit = sizeof(void*) == 8;
+
+const size_t Memory::TempMemoryRequired = Is64Bit ? Gigabytes(1) : Megabytes(256);
+const size_t Memory::ThreadTempMemoryRequired = Is64Bit ? Megabytes(64) : Megabytes(8);
+const size_t Memory::FrameMemoryRequired = Is64Bit ? Megabytes(64) : Megabytes(16);
+const size_t Memory::BulkMemoryRequired = Is64Bit ? 4 * Gigabytes(1) : Megabytes(128);
+const size_t Memory::HeapMemoryRequired = Is64Bit ? Gigabytes(1) : Megabytes(64);
+const size_t Memory::TotalMemoryRequired = TempMemoryRequired + MaxTempThreads * ThreadTempMemoryRequired + 2 * FrameMemoryRequired + BulkMemoryRequired + HeapMemoryRequired;
 
 MemoryState Memory::g_Memory{0};
-TempScopesHolder Memory::g_TempScopes{0};
+TLSFHeap Memory::g_Heap{0};
+thread_local TempMemoryRegion Memory::g_TempRegion{0};
+thread_local BulkChunk Memory::g_BulkChunk{0};
 
 static const inline size_t SIZE_BYTES = sizeof(size_t);
 
-void* MemoryArena::GetMemory(size_t len)
+static_assert(sizeof(MemoryState::ThreadsTempCommitted) / sizeof(size_t) == Memory::MaxTempThreads,
+			  "Every temporary memory slot needs its commit counter");
+
+void* MemoryArena::GetMemory(size_t len, size_t t_Align)
 {
-	Assert(Size + len <= MaxSize, "Can't get this much data from this memory arena");
-	Size += len;
-	Current += len;
+	const size_t padding = AlignmentPadding(Current, t_Align);
+	Assert(Size + padding + len <= MaxSize, "Can't get this much data from this memory arena");
+	Size += padding + len;
+	Current += padding + len;
 	return (void*)(Current - len);
 }
 
@@ -35,26 +48,71 @@ void MemoryArena::Reset()
 	Current = Memory;
 }
 
-static bool ArenaHasPlace(MemoryArena& t_Arena, size_t t_Size)
+[[maybe_unused]] static bool ArenaHasPlace(MemoryArena& t_Arena, size_t t_Size)
 {
 	return t_Size <= (t_Arena.MaxSize - t_Arena.Size);
 }
 
-static void* ArenaAllocation(MemoryArena& t_Arena, size_t t_Size)
+[[maybe_unused]] static bool EnoughTempMemory(size_t t_Size)
 {
-	auto memory = t_Arena.Get<size_t>(t_Size + SIZE_BYTES);
-	*memory = t_Size;
-	return memory + 1;
+	return t_Size <= (Memory::g_TempRegion.MaxSize - Memory::g_TempRegion.Size);
 }
 
-static bool EnoughTempMemory(size_t t_Size)
+static void CommitMemory(char* t_Base, size_t& t_Committed, size_t t_Required, size_t t_MaxSize)
 {
-	return t_Size <= (Memory::g_Memory.TempMemoryMaxSize - Memory::g_Memory.TempMemorySize);
+	if (t_Required <= t_Committed) return;
+
+	const size_t granularity = Memory::g_Memory.CommitGranularity;
+	size_t target = (t_Required + granularity - 1) & ~(granularity - 1);
+	target = target > t_MaxSize ? t_MaxSize : target;
+
+	[[maybe_unused]] const bool committed = PlatformLayer::Commit(t_Base + t_Committed, target - t_Committed);
+	Assert(committed, "Can't commit {} bytes of memory", target - t_Committed);
+
+	Telemetry::AddCommittedMemory(target - t_Committed);
+	t_Committed = target;
 }
 
-static bool EnoughBulkMemory(size_t t_Size)
+static void CommitRegion(SharedRegion& t_Region, size_t t_Required)
 {
-	return t_Size <= (Memory::g_Memory.BulkMemoryMaxSize - Memory::g_Memory.BulkMemorySize);
+	if (t_Required <= t_Region.Committed.load(std::memory_order_acquire)) return;
+
+	// @Note: Rare enough to not be worth anything smarter; a thread that
+	// got its memory has to wait until the pages under it are committed
+	auto& lock = Memory::g_Memory.CommitLock;
+	while (lock.exchange(true, std::memory_order_acquire)) {}
+
+	size_t committed = t_Region.Committed.load(std::memory_order_relaxed);
+	CommitMemory(t_Region.Memory, committed, t_Required, t_Region.MaxSize);
+	t_Region.Committed.store(committed, std::memory_order_release);
+
+	lock.store(false, std::memory_order_release);
+}
+
+// @Note: The padding depends on where the allocation ends up so the size
+// is moved with a compare-exchange instead of a plain fetch-add; returns
+// nullptr if the region can't fit the allocation
+static char* RegionBump(SharedRegion& t_Region, size_t t_Size, size_t t_Align, size_t& t_Padding)
+{
+	size_t size = t_Region.Size.load(std::memory_order_relaxed);
+	do
+	{
+		t_Padding = AlignmentPadding(t_Region.Memory + size, t_Align);
+		if (t_Padding + t_Size > t_Region.MaxSize - size) return nullptr;
+	}
+	while (!t_Region.Size.compare_exchange_weak(size, size + t_Padding + t_Size, std::memory_order_relaxed));
+
+	CommitRegion(t_Region, size + t_Padding + t_Size);
+	Telemetry::AddMemory(Memory_Bulk, t_Padding + t_Size);
+	return t_Region.Memory + size + t_Padding;
+}
+
+static void InitRegion(SharedRegion& t_Region, char* t_Memory, size_t t_MaxSize)
+{
+	t_Region.Memory = t_Memory;
+	t_Region.Size = 0;
+	t_Region.MaxSize = t_MaxSize;
+	t_Region.Committed = 0;
 }
 
 static size_t BlockSize(void* t_Mem)
@@ -67,133 +125,382 @@ static void SetBlockSize(void* t_Mem, size_t t_Size)
 	*((size_t*)t_Mem - 1) = t_Size;
 }
 
-void Memory::InitMemoryState()
+static char* TempRegionGet(size_t t_Size)
+{
+	auto& region = Memory::g_TempRegion;
+	Assert(region.Memory, "This thread has no temporary memory; call Memory::InitThreadTempMemory first");
+	Assert(EnoughTempMemory(t_Size), "There is not enough temporary memory: {}", t_Size);
+
+	char* memory = region.Current;
+	region.Current += t_Size;
+	region.Size += t_Size;
+	CommitMemory(region.Memory, region.Committed, region.Size, region.MaxSize);
+
+	return memory;
+}
+
+static void TempRegionRollback(char* t_Position)
+{
+	auto& region = Memory::g_TempRegion;
+	Assert(t_Position >= region.Memory && t_Position <= region.Current, "Rolling back to a point that is not in the temporary memory");
+
+	region.Current = t_Position;
+	region.Size = t_Position - region.Memory;
+}
+
+void Memory::InitMemoryState(const MemorySettings& t_Settings)
 {
-	g_Memory.TempMemory = (char*)PlatformLayer::Allocate(TotalMemoryRequired);
-	g_Memory.TempMemorySize = 0;
+	g_Memory.HugePages = t_Settings.HugePages;
+	g_Memory.CommitGranularity = t_Settings.HugePages ? Megabytes(2) : Kilobytes(64);
+
+	// @Note: The budgets go after the heap memory; each one starts at a
+	// commit boundary so that the systems never share pages
+	const size_t granularity = Megabytes(2);
+	size_t budgetsSize = 0;
+	for (uint32 tag = 0; tag < Tags_Count; ++tag)
+	{
+		budgetsSize += (t_Settings.Budgets[tag] + granularity - 1) & ~(granularity - 1);
+	}
+	Assert(t_Settings.Budgets[Tag_Unknown] == 0, "The unknown tag can't have a memory budget");
+
+	const size_t totalMemory = TotalMemoryRequired + budgetsSize;
+	g_Memory.TempMemory = (char*)PlatformLayer::Reserve(totalMemory, t_Settings.HugePages);
+	Assert(g_Memory.TempMemory, "Can't reserve {} bytes of memory", totalMemory);
+	Telemetry::AddReservedMemory(totalMemory);
+
 	g_Memory.TempMemoryMaxSize = TempMemoryRequired;
-	g_Memory.TempMemoryCurrent = Memory::g_Memory.TempMemory;
 
-	g_Memory.BulkMemory = Memory::g_Memory.TempMemory + TempMemoryRequired;
-	g_Memory.BulkMemoryCurrent = g_Memory.BulkMemory;
-	g_Memory.BulkMemorySize = 0;
-	g_Memory.BulkMemoryMaxSize = BulkMemoryRequired;
+	g_Memory.ThreadsTempMemory = g_Memory.TempMemory + TempMemoryRequired;
+	g_Memory.ThreadsTempSlots = 0;
+
+	char* frameMemory = g_Memory.ThreadsTempMemory + MaxTempThreads * ThreadTempMemoryRequired;
+	for (uint8 i = 0; i < 2; ++i)
+	{
+		auto& arena = g_Memory.FrameArenas[i];
+		arena.Memory = frameMemory + i * FrameMemoryRequired;
+		arena.Current = arena.Memory;
+		arena.MaxSize = FrameMemoryRequired;
+		arena.Size = 0;
+		g_Memory.FrameArenasCommitted[i] = 0;
+	}
+	g_Memory.CurrentFrameArena = 0;
+
+	InitRegion(g_Memory.Bulk, frameMemory + 2 * FrameMemoryRequired, BulkMemoryRequired);
+	for (uint32 tag = 0; tag < Tags_Count; ++tag) g_Memory.BulkTagSizes[tag] = 0;
+	g_Memory.BulkGeneration = 1;
+	g_Memory.CommitLock = false;
+
+	auto& heapMemory = g_Memory.HeapMemory;
+	InitRegion(heapMemory.Region, g_Memory.Bulk.Memory + BulkMemoryRequired, HeapMemoryRequired);
+	heapMemory.Heap = &g_Heap;
+
+	g_Heap.Owner = Tag_Unknown;
+
+	char* budgetMemory = heapMemory.Region.Memory + HeapMemoryRequired;
+	for (uint32 tag = 0; tag < Tags_Count; ++tag)
+	{
+		auto& budget = g_Memory.Budgets[tag];
+		InitRegion(budget.Region, nullptr, 0);
+		budget.Heap = nullptr;
+		if (t_Settings.Budgets[tag] == 0) continue;
+
+		InitRegion(budget.Region, budgetMemory, t_Settings.Budgets[tag]);
+		budgetMemory += (t_Settings.Budgets[tag] + granularity - 1) & ~(granularity - 1);
+
+		budget.Heap = (TLSFHeap*)BudgetGet((SystemTag)tag, sizeof(TLSFHeap), alignof(TLSFHeap));
+		new (budget.Heap) TLSFHeap{0};
+		budget.Heap->Owner = (SystemTag)tag;
+	}
+
+	g_TempRegion.Memory = g_Memory.TempMemory;
+	g_TempRegion.Current = g_TempRegion.Memory;
+	g_TempRegion.Size = 0;
+	g_TempRegion.MaxSize = TempMemoryRequired;
+	g_TempRegion.Committed = 0;
+	g_TempRegion.Scope = nullptr;
+	g_TempRegion.Slot = -1;
+}
+
+void Memory::InitThreadTempMemory()
+{
+	Assert(!g_TempRegion.Memory, "This thread already owns temporary memory");
+
+	// @Note: Grab the first free slot; the slots are a bitmask so that
+	// the threads can claim them without taking any lock
+	uint32 slots = g_Memory.ThreadsTempSlots.load();
+	int8 slot;
+	do
+	{
+		slot = -1;
+		for (int8 i = 0; i < MaxTempThreads; ++i)
+		{
+			if ((slots & (1u << i)) == 0) { slot = i; break; }
+		}
+		Assert(slot != -1, "Too many threads are using temporary memory: {}", MaxTempThreads);
+	}
+	while (!g_Memory.ThreadsTempSlots.compare_exchange_weak(slots, slots | (1u << slot)));
+
+	g_TempRegion.Memory = g_Memory.ThreadsTempMemory + slot * ThreadTempMemoryRequired;
+	g_TempRegion.Current = g_TempRegion.Memory;
+	g_TempRegion.Size = 0;
+	g_TempRegion.MaxSize = ThreadTempMemoryRequired;
+	g_TempRegion.Committed = g_Memory.ThreadsTempCommitted[slot];
+	g_TempRegion.Scope = nullptr;
+	g_TempRegion.Slot = slot;
 }
 
-MemoryArena Memory::GetTempArena(size_t t_Size)
+void Memory::ReleaseThreadTempMemory()
 {
-	Assert(EnoughTempMemory(t_Size), "There is not enough space in this memory arena");
+	Assert(g_TempRegion.Slot != -1, "Only worker threads can release their temporary memory");
+	Assert(g_TempRegion.Scope == nullptr, "Releasing thread temporary memory while there are open scopes");
+
+	g_Memory.ThreadsTempCommitted[g_TempRegion.Slot] = g_TempRegion.Committed;
+	g_Memory.ThreadsTempSlots.fetch_and(~(1u << g_TempRegion.Slot));
+	g_TempRegion = {0};
+}
+
+MemoryArena Memory::GetTempArena(size_t t_Size, size_t t_Align)
+{
+	const size_t padding = AlignmentPadding(g_TempRegion.Current, t_Align);
 
 	MemoryArena arena;
 	arena.MaxSize = t_Size;
 	arena.Size = 0;
-	arena.Memory = Memory::g_Memory.TempMemoryCurrent;
+	arena.Memory = TempRegionGet(padding + t_Size) + padding;
 	arena.Current = arena.Memory;
 
-	Memory::g_Memory.TempMemoryCurrent += t_Size;
-	Memory::g_Memory.TempMemorySize += t_Size;
-
 	return arena;
 }
 
 void Memory::DestoryTempArena(MemoryArena& t_Arena)
 {
-	Assert(t_Arena.Memory == (Memory::g_Memory.TempMemoryCurrent - t_Arena.MaxSize),
-		   "Trying to destory temporary memory arena out of order. There is something wrong with the code");
+	if (t_Arena.Memory + t_Arena.MaxSize != g_TempRegion.Current) return;
 
-	Memory::g_Memory.TempMemoryCurrent -= t_Arena.MaxSize;
-	Memory::g_Memory.TempMemorySize -= t_Arena.MaxSize;	
+	TempRegionRollback(t_Arena.Memory);
 }
 
 void Memory::ResetTempMemory()
 {
-	Memory::g_Memory.TempMemoryCurrent = Memory::g_Memory.TempMemory;
-	Memory::g_Memory.TempMemorySize = 0;
-	Memory::g_TempScopes = {0};
-	
+	TempRegionRollback(g_TempRegion.Memory);
+	g_TempRegion.Scope = nullptr;
 }
 
-void Memory::EstablishTempScope(size_t t_Size)
+void Memory::EstablishTempScope()
 {
-g_TempScopes.PushScope(GetTempArena(t_Size));
+	auto scope = (TempScope*)TempRegionGet(sizeof(TempScope));
+	scope->Previous = g_TempRegion.Scope;
+	g_TempRegion.Scope = scope;
 }
 
 void Memory::EndTempScope()
 {
-	DestoryTempArena(g_TempScopes.GetCurrentArena());
-	g_TempScopes.PopScope();
+	TempScope* scope = g_TempRegion.Scope;
+	Assert(scope, "Currently there is no temporary memory scope");
+
+	g_TempRegion.Scope = scope->Previous;
+	TempRegionRollback((char*)scope);
 }
 
 void Memory::ResetTempScope()
 {
-	MemoryArena& arena = g_TempScopes.GetCurrentArena();
-	arena.Size = 0;
-	arena.Current = arena.Memory;
+	Assert(g_TempRegion.Scope, "Currently there is no temporary memory scope");
+	TempRegionRollback((char*)(g_TempRegion.Scope + 1));
 }
 
-void* Memory::TempAlloc(size_t t_Size)
+TempSavepoint Memory::SaveTemp()
 {
-	auto& arena = g_TempScopes.GetCurrentArena();
-	Assert(arena.Memory, "Currently there is no temporary memory scope");
+	return TempSavepoint{ g_TempRegion.Current, g_TempRegion.Scope };
+}
 
-	if(ArenaHasPlace(arena, t_Size))
-	{
-		return ArenaAllocation(arena, t_Size);
-	}
+void Memory::RollbackTemp(const TempSavepoint& t_Savepoint)
+{
+	g_TempRegion.Scope = t_Savepoint.Scope;
+	TempRegionRollback(t_Savepoint.Current);
+}
 
-	Assert(false, "The current temporary scope has not enough space.");
-	return nullptr;
+void* Memory::TempAlloc(size_t t_Size, size_t t_Align)
+{
+	Assert(g_TempRegion.Scope, "Currently there is no temporary memory scope");
+
+	// @Note: The size of the block sits right before it
+	const size_t padding = AlignmentPadding(g_TempRegion.Current + SIZE_BYTES, t_Align);
+	auto memory = (size_t*)(TempRegionGet(padding + SIZE_BYTES + t_Size) + padding);
+	*memory = t_Size;
+	return memory + 1;
 }
 
 void* Memory::TempRealloc(void* t_Mem, size_t t_Size)
 {
-	auto& arena = g_TempScopes.GetCurrentArena();
-	
 	if (!t_Mem) return Memory::TempAlloc(t_Size);
 
 	auto oldSize = BlockSize(t_Mem);
-	
-	if(((char*)t_Mem - SIZE_BYTES) == (arena.Current - oldSize - SIZE_BYTES))
+
+	// @Note: The last block in the scratch memory can grow in place
+	if ((char*)t_Mem + oldSize == g_TempRegion.Current)
 	{
-		arena.Size += t_Size - oldSize;
-		arena.Current += t_Size - oldSize;
+		if (t_Size > oldSize) TempRegionGet(t_Size - oldSize);
+		else TempRegionRollback((char*)t_Mem + t_Size);
 		SetBlockSize(t_Mem, t_Size);
 		return t_Mem;
 	}
 
 	auto newBlock = TempAlloc(t_Size);
-	memcpy(newBlock, t_Mem, oldSize);
+	memcpy(newBlock, t_Mem, oldSize < t_Size ? oldSize : t_Size);
 	return newBlock;
 }
 
 void Memory::TempDealloc(void*)
 {}
 
-void* Memory::BulkGet(size_t t_Size, SystemTag Tag)
+void* Memory::FrameAlloc(size_t t_Size, size_t t_Align)
 {
-	Assert(EnoughBulkMemory(t_Size), "Not enough bulk memory");
-	auto res = g_Memory.BulkMemoryCurrent;
+	// @Note: Only the main thread has the temp region at the start of the temp memory
+	Assert(g_TempRegion.Memory == g_Memory.TempMemory, "The frame memory can be used only on the main thread");
 
-	g_Memory.BulkMemoryCurrent += t_Size;
-	g_Memory.BulkMemorySize += t_Size;
+	const uint8 current = g_Memory.CurrentFrameArena;
+	auto& arena = g_Memory.FrameArenas[current];
 
-	Telemetry::AddMemory(Memory_Bulk, t_Size);
-	Telemetry::AddMemory(Tag, t_Size);
-	
-	return res;
-}	
+	Assert(ArenaHasPlace(arena, t_Size + AlignmentPadding(arena.Current, t_Align)), "Not enough frame memory: {}", t_Size);
 
-void* Memory::BulkGet(size_t t_Size)
+	void* memory = arena.GetMemory(t_Size, t_Align);
+	CommitMemory(arena.Memory, g_Memory.FrameArenasCommitted[current], arena.Size, arena.MaxSize);
+	return memory;
+}
+
+void Memory::FlipFrameMemory()
+{
+	Telemetry::RecordFrameMemory(g_Memory.FrameArenas[g_Memory.CurrentFrameArena].Size);
+
+	// @Note: The other arena still holds the previous frame; from now on
+	// nobody can look at it
+	g_Memory.CurrentFrameArena ^= 1;
+	g_Memory.FrameArenas[g_Memory.CurrentFrameArena].Reset();
+}
+
+void* Memory::BudgetGet(SystemTag Tag, size_t t_Size, size_t t_Align)
+{
+	auto& budget = g_Memory.Budgets[Tag];
+	Assert(budget.Region.Memory, "[{}] has no memory budget", gSystemTagNames[Tag]);
+
+	size_t padding;
+	char* memory = RegionBump(budget.Region, t_Size, t_Align, padding);
+	Assert(memory, "[{}] is over its memory budget of {:.3f} MBs",
+		   gSystemTagNames[Tag], budget.Region.MaxSize / (1024.0f*1024.0f));
+
+	return memory;
+}
+
+void* Memory::HeapPoolGet(SystemTag Owner, size_t t_Size, size_t t_Align)
 {
-	Assert(EnoughBulkMemory(t_Size), "Not enough bulk memory");
-	auto res = g_Memory.BulkMemoryCurrent;
+	if (Owner != Tag_Unknown) return BudgetGet(Owner, t_Size, t_Align);
+
+	size_t padding;
+	char* memory = RegionBump(g_Memory.HeapMemory.Region, t_Size, t_Align, padding);
+	Assert(memory, "Not enough heap memory for a pool of {} bytes", t_Size);
+
+	return memory;
+}
 
-	g_Memory.BulkMemoryCurrent += t_Size;
-	g_Memory.BulkMemorySize += t_Size;
+BulkMarker Memory::MarkBulk()
+{
+	// @Note: The chunks that the threads hold are before the marker; the
+	// next allocations have to come after it
+	g_Memory.BulkGeneration.fetch_add(1);
+
+	BulkMarker marker;
+	marker.BulkSize = g_Memory.Bulk.Size.load();
+	for (uint32 tag = 0; tag < Tags_Count; ++tag)
+	{
+		marker.BudgetSizes[tag] = g_Memory.Budgets[tag].Region.Size.load();
+		marker.TagSizes[tag] = g_Memory.BulkTagSizes[tag].load();
+	}
+	return marker;
+}
+
+void Memory::RollbackBulk(const BulkMarker& t_Marker)
+{
+	const size_t bulkSize = g_Memory.Bulk.Size.load();
+	Assert(t_Marker.BulkSize <= bulkSize, "The bulk memory is already behind this marker");
+
+	g_Memory.BulkGeneration.fetch_add(1);
+	Telemetry::RemoveMemory(Memory_Bulk, bulkSize - t_Marker.BulkSize);
+	g_Memory.Bulk.Size = t_Marker.BulkSize;
+
+	for (uint32 tag = 0; tag < Tags_Count; ++tag)
+	{
+		auto& budget = g_Memory.Budgets[tag];
+		if (budget.Region.Memory)
+		{
+			// @Note: The pools of the budget heap share the region with the
+			// bulk allocations and they can't be given back; the budget only
+			// goes back to the end of its last pool
+			const size_t heapEnd = budget.Heap->LastPoolEnd ? budget.Heap->LastPoolEnd - budget.Region.Memory : 0;
+			const size_t size = t_Marker.BudgetSizes[tag] < heapEnd ? heapEnd : t_Marker.BudgetSizes[tag];
+			const size_t budgetSize = budget.Region.Size.load();
+			if (size < budgetSize)
+			{
+				Telemetry::RemoveMemory(Memory_Bulk, budgetSize - size);
+				budget.Region.Size = size;
+			}
+		}
+
+		// @Note: The objects of the tag are gone even when the space they
+		// took is kept for a pool of the budget heap
+		Telemetry::RemoveMemory((SystemTag)tag, g_Memory.BulkTagSizes[tag] - t_Marker.TagSizes[tag]);
+		g_Memory.BulkTagSizes[tag] = t_Marker.TagSizes[tag];
+	}
+}
+
+void Memory::RollbackBulk(const BulkMarker& t_Start, const BulkMarker& t_End)
+{
+	Assert(g_Memory.Bulk.Size.load() == t_End.BulkSize, "Somebody took bulk memory after the end marker: {} bytes", g_Memory.Bulk.Size.load() - t_End.BulkSize);
+	for (uint32 tag = 0; tag < Tags_Count; ++tag)
+	{
+		// @Note: The budget heap may have grown a pool since; that is fine
+		// as the rollback does not go past the pools
+		auto& budget = g_Memory.Budgets[tag];
+		if (!budget.Region.Memory) continue;
+
+		const size_t heapEnd = budget.Heap->LastPoolEnd ? budget.Heap->LastPoolEnd - budget.Region.Memory : 0;
+		[[maybe_unused]] const size_t end = t_End.BudgetSizes[tag] < heapEnd ? heapEnd : t_End.BudgetSizes[tag];
+		Assert(budget.Region.Size.load() <= end, "Somebody took memory from the [{}] budget after the end marker", gSystemTagNames[tag]);
+	}
+
+	RollbackBulk(t_Start);
+}
+
+void* Memory::BulkGet(size_t t_Size, SystemTag Tag, size_t t_Align)
+{
+	g_Memory.BulkTagSizes[Tag].fetch_add(t_Size, std::memory_order_relaxed);
+	Telemetry::AddMemory(Tag, t_Size);
+
+	if (g_Memory.Budgets[Tag].Region.Memory) return BudgetGet(Tag, t_Size, t_Align);
+
+	size_t padding;
+	if (t_Size + t_Align > BulkChunkMaxAlloc)
+	{
+		char* memory = RegionBump(g_Memory.Bulk, t_Size, t_Align, padding);
+		Assert(memory, "Not enough bulk memory for [{}]", gSystemTagNames[Tag]);
+		return memory;
+	}
+
+	// @Note: Small allocations come from the chunk of the thread; the
+	// rest of a chunk that can't fit the allocation is just left unused
+	auto& chunk = g_BulkChunk;
+	const uint32 generation = g_Memory.BulkGeneration.load(std::memory_order_relaxed);
+	padding = AlignmentPadding(chunk.Current, t_Align);
+	if (chunk.Generation != generation || padding + t_Size > size_t(chunk.End - chunk.Current))
+	{
+		chunk.Current = RegionBump(g_Memory.Bulk, BulkChunkSize, CacheLineSize, padding);
+		Assert(chunk.Current, "Not enough bulk memory for [{}]", gSystemTagNames[Tag]);
+		chunk.End = chunk.Current + BulkChunkSize;
+		chunk.Generation = generation;
+		padding = AlignmentPadding(chunk.Current, t_Align);
+	}
 
-	Telemetry::AddMemory(Memory_Bulk, t_Size);
-	
-	return res;
+	char* memory = chunk.Current + padding;
+	chunk.Current = memory + t_Size;
+	return memory;
 }	
 
 void* TempAlloc(size_t size)
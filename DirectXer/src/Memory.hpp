@@ -6,11 +6,20 @@
 #include <Logging.hpp>
 #include <GraphicsCommon.hpp>
 #include <Tags.hpp>
+#include <MemoryHeap.hpp>
 
 #include <vector>
 #include <string>
+#include <atomic>
 #include <robin_hood.h>
 
+// @Note: How many bytes have to be skipped so that t_Pointer becomes a
+// multiple of t_Align; t_Align has to be a power of two
+inline size_t AlignmentPadding(const void* t_Pointer, size_t t_Align)
+{
+	return (t_Align - ((size_t)t_Pointer & (t_Align - 1))) & (t_Align - 1);
+}
+
 struct MemoryArena
 {
 	char* Memory;
@@ -19,7 +28,7 @@ struct MemoryArena
 	size_t Size;
 
 	void Put(const void* data, size_t len);
-	void* GetMemory(size_t len);
+	void* GetMemory(size_t len, size_t t_Align = 1);
 	void Reset();
 
 	template<typename T>
@@ -28,85 +37,235 @@ struct MemoryArena
 		Put(&value, sizeof(T));
 	}
 
+	// @Note: The arenas are also used as tightly packed blobs so nothing
+	// is aligned unless asked for
 	template<typename T = void>
-	T* Get(size_t len)
+	T* Get(size_t len, size_t t_Align = 1)
 	{
-		return (T*)GetMemory(len);
+		return (T*)GetMemory(len, t_Align);
 	}
 };
 
+// @Note: Reserved memory that any number of threads can bump allocate
+// from at the same time; the size is only ever moved with atomic
+// operations and the pages are committed under a short spin lock that
+// is only taken when the region grows past its committed pages
+struct SharedRegion
+{
+	char* Memory;
+	std::atomic<size_t> Size;
+	size_t MaxSize;
+	std::atomic<size_t> Committed;
+};
+
+// @Note: A system with a budget gets its own piece of the reserved
+// memory; its bulk allocations and the pools of its heap come only from
+// there so they stay together and can't go over the budget
+struct MemoryBudget
+{
+	SharedRegion Region;
+	TLSFHeap* Heap;
+};
+
+// @Note: The piece of the bulk memory that a thread allocates from
+// without touching the shared counter; it is refilled with a whole
+// chunk at a time. The generation tells when the chunk was invalidated
+// by a bulk marker
+struct BulkChunk
+{
+	char* Current;
+	char* End;
+	uint32 Generation;
+};
+
+// @Note: A point in the bulk memory and in every budget that can be
+// rolled back to; everything that was taken after the marker goes away
+// at once. The heap is not part of the bulk memory so its pools are
+// never touched by a rollback
+struct BulkMarker
+{
+	size_t BulkSize;
+	size_t BudgetSizes[Tags_Count];
+	size_t TagSizes[Tags_Count];
+};
+
+struct MemorySettings
+{
+	bool HugePages;
+	// @Note: Zero means that the system shares the common bulk memory
+	size_t Budgets[Tags_Count];
+};
+
 struct MemoryState
 {
 	char* TempMemory;
-	char* TempMemoryCurrent;
 	size_t TempMemoryMaxSize;
-	size_t TempMemorySize;
-	
-	char* BulkMemory;
-	char* BulkMemoryCurrent;
-	size_t BulkMemorySize;
-	size_t BulkMemoryMaxSize;
 
+	// @Note: The memory that gets split between the worker threads;
+	// every thread that calls InitThreadTempMemory gets one slot of it
+	char* ThreadsTempMemory;
+	std::atomic<uint32> ThreadsTempSlots;
+	// @Note: One per Memory::MaxTempThreads; the committed pages stay
+	// with the slot when a thread gives it back
+	size_t ThreadsTempCommitted[8];
+
+	// @Note: Two arenas that take turns; one holds the allocations of
+	// the current frame, the other the ones of the previous frame
+	MemoryArena FrameArenas[2];
+	size_t FrameArenasCommitted[2];
+	uint8 CurrentFrameArena;
+	
+	SharedRegion Bulk;
+	// @Note: How much of the bulk memory each tag has taken; needed to
+	// fix up the telemetry when the bulk memory is rolled back
+	std::atomic<size_t> BulkTagSizes[Tags_Count];
+	// @Note: Bumped by every marker and rollback; the chunks of the
+	// threads from an older generation are not used anymore
+	std::atomic<uint32> BulkGeneration;
+
+	// @Note: The common heap has a region of its own so that the bulk
+	// memory stays a pure stack that can be rolled back
+	MemoryBudget HeapMemory;
+
+	MemoryBudget Budgets[Tags_Count];
+
+	// @Note: The memory is only reserved upfront; the pages are
+	// committed in steps of CommitGranularity as the regions grow
+	size_t CommitGranularity;
+	std::atomic<bool> CommitLock;
+	bool HugePages;
 };
 
-struct TempScopesHolder
+// @Note: Every temp scope starts with one of those in the scratch
+// memory itself; they link back to the enclosing scope so there is no
+// limit on how deep the scopes can go
+struct TempScope
 {
-	inline static const uint8 MaxTempScopes = 8;
- 
-	MemoryArena Scopes[MaxTempScopes];
-	uint8 CurrentScope{0};
+	TempScope* Previous;
+};
 
-	inline MemoryArena& GetCurrentArena()
-	{
-		return Scopes[CurrentScope - 1];
-	}
-	
-	inline void PushScope(MemoryArena t_Arena)
-	{
-		Assert(CurrentScope < MaxTempScopes, "Too many temporary memory scopes: {}", MaxTempScopes);
-		Scopes[CurrentScope++] = t_Arena;
-	}
+// @Note: A point in the scratch memory of a thread that can be rolled
+// back to; everything allocated after the savepoint goes away
+struct TempSavepoint
+{
+	char* Current;
+	TempScope* Scope;
+};
 
-	inline void PopScope()
-	{
-		Scopes[CurrentScope--] = MemoryArena{0};
-	}
+// @Note: The part of the temporary memory that a single thread
+// owns; it is one scratch arena that only grows and gets rolled
+// back. GetTempArena\DestoryTempArena and the temp scopes work only on
+// the region of the calling thread so the threads never touch each
+// other's memory
+struct TempMemoryRegion
+{
+	char* Memory;
+	char* Current;
+	size_t Size;
+	size_t MaxSize;
+	size_t Committed;
+	TempScope* Scope;
+	int8 Slot;
 };
 
 struct Memory
 {
+	inline static const uint8 MaxTempThreads = 8;
+	inline static const size_t BulkChunkSize = Kilobytes(64);
+	// @Note: Anything bigger than that goes straight to the shared
+	// counter; the chunks are for the many small allocations
+	inline static const size_t BulkChunkMaxAlloc = BulkChunkSize / 8;
+
 	const static size_t TempMemoryRequired;
+	const static size_t ThreadTempMemoryRequired;
+	const static size_t FrameMemoryRequired;
 	const static size_t BulkMemoryRequired;
+	const static size_t HeapMemoryRequired;
 	const static size_t TotalMemoryRequired;
 	static MemoryState g_Memory;
-	static TempScopesHolder g_TempScopes;
+	static TLSFHeap g_Heap;
+	static thread_local TempMemoryRegion g_TempRegion;
+	static thread_local BulkChunk g_BulkChunk;
 
-	static void* BulkGet(size_t t_Size, SystemTag Tag = Tag_Unknown);
-	static void* BulkGet(size_t t_Size);
+	// @Note: All of the allocation functions take an alignment which
+	// has to be a power of two. BulkGet, BudgetGet and the heap pools can
+	// be used from any thread without locking
+	static void* BulkGet(size_t t_Size, SystemTag Tag = Tag_Unknown, size_t t_Align = DefaultAlignment);
 
 	template<typename T>
 	static T* BulkGetType(size_t t_Size  = 1, SystemTag Tag = Tag_Unknown)
 	{
-		return (T*)BulkGet(t_Size*sizeof(T), Tag);
+		return (T*)BulkGet(t_Size*sizeof(T), Tag, alignof(T));
 	}
 
+	// @Note: Remember where the bulk memory is and later give back
+	// everything that was taken after that; the markers work like a stack
+	// -- rolling back to a marker invalidates all of the markers that were
+	// taken after it. No other thread may be allocating bulk memory while
+	// a marker is taken or rolled back to
+	static BulkMarker MarkBulk();
+	static void RollbackBulk(const BulkMarker& t_Marker);
+
+	// @Note: For memory that one system owns between two markers (a level
+	// for example); the rollback would pull everything that others took
+	// after t_End from under them so there must not be anything like that
+	static void RollbackBulk(const BulkMarker& t_Start, const BulkMarker& t_End);
+
+	// @Note: General purpose allocations that can be given back; the
+	// heap lives in its own region; see MemoryHeap.hpp. Any thread can
+	// use the heap, each heap is behind a short spin lock
+	static void* HeapAlloc(size_t t_Size, SystemTag Tag = Tag_Unknown, size_t t_Align = DefaultAlignment);
+	static void HeapFree(void* t_Memory);
+	static bool HeapExpand(void* t_Memory, size_t t_Size);
+
+	// @Note: Raw memory from the budget of a system; this is where its
+	// heap takes its pools from
+	static void* BudgetGet(SystemTag Tag, size_t t_Size, size_t t_Align = DefaultAlignment);
+
+	// @Note: Memory for a new pool of the heap of the given owner; the
+	// common heap (Tag_Unknown) takes it from the heap region, the heaps of
+	// the budgets from their budget
+	static void* HeapPoolGet(SystemTag Owner, size_t t_Size, size_t t_Align);
+
+	// @Note: Fixed size object pool on top of the bulk memory; the
+	// definition is in MemoryPool.hpp
+	template<typename T, SystemTag Tag = Tag_Unknown>
+	struct Pool;
+
 	// @Note: Get some storage in arena form, use it and then
-	// give it back
-	static MemoryArena GetTempArena(size_t t_Size);
+	// give it back; giving back an arena that is not the last thing in
+	// the scratch memory does nothing -- its space is reclaimed when the
+	// enclosing scope or savepoint is rolled back
+	static MemoryArena GetTempArena(size_t t_Size, size_t t_Align = DefaultAlignment);
 	static void DestoryTempArena(MemoryArena& t_Arena);
 
-	// @Note: Establish global temporary arena that will be used for
+	// @Note: Establish a temporary scope that will be used for
 	// TempAlloc\TempRealoc; those can them be used are general allocators
 	// but you should be mindfull of the temporary aspect
 	//   -> Linear allocation
 	//   -> Limited reallocations
 	//   -> There are no deallocations
-	static void EstablishTempScope(size_t t_Size);
+	// The scopes don't reserve anything upfront; they just remember where
+	// the scratch memory was and can be nested as deep as needed
+	static void EstablishTempScope();
 	static void EndTempScope();
-	static void* TempAlloc(size_t len);
+	static void* TempAlloc(size_t len, size_t t_Align = DefaultAlignment);
 	static void* TempRealloc(void* mem, size_t len);
 	static void TempDealloc(void*);
 
+	// @Note: Lightweight markers in the scratch memory; take one, use
+	// temp memory and roll back to it to give everything back at once
+	static TempSavepoint SaveTemp();
+	static void RollbackTemp(const TempSavepoint& t_Savepoint);
+
+	// @Note: Memory that lives for two frames without anyone having to
+	// free it; whatever gets allocated in frame N stays valid until the
+	// end of frame N+1. FlipFrameMemory starts a new frame and is called
+	// by the App at the beginning of every update. Only for the main
+	// thread
+	static void* FrameAlloc(size_t t_Size, size_t t_Align = DefaultAlignment);
+	static void FlipFrameMemory();
+
     //  @Note: Reset the Current temp global temp scope arena
 	// to its initial state 
 	static void ResetTempScope();
@@ -116,8 +275,16 @@ struct Memory
 	// as invalid after that
 	static void ResetTempMemory();
 
-	// @Note: Initalize the whole memory by requesting memory from the OS
-	static void InitMemoryState();
+	// @Note: Initalize the whole memory by requesting memory from the OS;
+	// the calling thread becomes the owner of the main temporary region
+	static void InitMemoryState(const MemorySettings& t_Settings = {});
+
+	// @Note: Give the calling (worker) thread its own temporary
+	// region with its own scopes stack; after that TempVector, TempString
+	// and the rest can be used from the thread. The region has to be
+	// given back with ReleaseThreadTempMemory before the thread exits
+	static void InitThreadTempMemory();
+	static void ReleaseThreadTempMemory();
 };
 
 template<typename T>
@@ -137,14 +304,19 @@ inline T& ReadBlobAndMove(char* &Current, size_t size)
 	return *res;
 }
 
-template<typename T>
+template<typename T, size_t Align = DefaultAlignment>
 class TempStdAllocator
 {
   public:
+	template<typename U>
+	struct rebind {
+		typedef TempStdAllocator<U, Align> other;
+	};
 
 	TempStdAllocator(){};
 	
-	TempStdAllocator(const TempStdAllocator&){};
+	template<typename U>
+	TempStdAllocator(const TempStdAllocator<U, Align>&){};
 
 	typedef T value_type;
 	typedef size_t size_type;
@@ -153,7 +325,7 @@ class TempStdAllocator
 
 	T* allocate(size_type t_Size)
 	{
-		return (T*)Memory::TempAlloc(sizeof(T) * t_Size);
+		return (T*)Memory::TempAlloc(sizeof(T) * t_Size, Align > alignof(T) ? Align : alignof(T));
 	}
 	
 	void deallocate(T* p, size_type)
@@ -164,19 +336,47 @@ class TempStdAllocator
 	inline bool operator==(TempStdAllocator const&) const { return true; }		
 };
 
-template<typename T, SystemTag Tag = Tag_Unknown>
+template<typename T>
+class FrameStdAllocator
+{
+  public:
+
+	FrameStdAllocator(){};
+
+	template<typename U>
+	FrameStdAllocator(const FrameStdAllocator<U>&){};
+
+	typedef T value_type;
+	typedef size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef std::true_type is_always_equal;
+
+	T* allocate(size_type t_Size)
+	{
+		return (T*)Memory::FrameAlloc(sizeof(T) * t_Size, DefaultAlignment > alignof(T) ? DefaultAlignment : alignof(T));
+	}
+	
+	void deallocate(T*, size_type)
+	{
+		// @Note: The memory goes away when the frame arena is flipped
+	}
+
+	inline bool operator==(FrameStdAllocator const&) const { return true; }
+};
+
+template<typename T, SystemTag Tag = Tag_Unknown, size_t Align = DefaultAlignment>
 class BulkStdAllocator
 {
   public:
 	template<typename U>
 	struct rebind {
-		typedef BulkStdAllocator<U, Tag> other;
+		typedef BulkStdAllocator<U, Tag, Align> other;
 	};
 
 	BulkStdAllocator(){};
 
 	template<typename U>
-	BulkStdAllocator(const BulkStdAllocator<U, Tag>&){};
+	BulkStdAllocator(const BulkStdAllocator<U, Tag, Align>&){};
 	
 	typedef T value_type;
 	typedef value_type* pointer;
@@ -188,12 +388,12 @@ class BulkStdAllocator
 
 	T* allocate(size_type t_Size)
 	{
-		return (T*)Memory::BulkGet(sizeof(T) * t_Size, Tag);
+		return (T*)Memory::HeapAlloc(sizeof(T) * t_Size, Tag, Align > alignof(T) ? Align : alignof(T));
 	}
 	
-	void deallocate(T*, size_type)
+	void deallocate(T* p, size_type)
 	{
-		//Assert(false, "Something using BulkStorage is trying to deallocate. This is not good.");
+		Memory::HeapFree(p);
 	}
 
 	inline bool operator==(BulkStdAllocator const&) const { return true; }
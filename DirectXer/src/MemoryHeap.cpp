@@ -0,0 +1,425 @@
+#include <MemoryHeap.hpp>
+#include <Memory.hpp>
+#include <Timing.hpp>
+
+#if defined(_WIN32)
+#include <intrin.h>
+#endif
+
+using BlockHeader = TLSFHeap::BlockHeader;
+using FreeLinks = TLSFHeap::FreeLinks;
+
+static const uint32 HeaderSize = sizeof(BlockHeader);
+static const uint32 MinBlockSize = sizeof(FreeLinks);
+
+static_assert(sizeof(BlockHeader) == TLSFHeap::Align, "The block header must keep the payloads aligned");
+
+static inline uint32 LowestBit(uint32 t_Value)
+{
+#if defined(_WIN32)
+	unsigned long index;
+	_BitScanForward(&index, t_Value);
+	return (uint32)index;
+#else
+	return (uint32)__builtin_ctz(t_Value);
+#endif
+}
+
+static inline uint32 HighestBit(uint32 t_Value)
+{
+#if defined(_WIN32)
+	unsigned long index;
+	_BitScanReverse(&index, t_Value);
+	return (uint32)index;
+#else
+	return 31u - (uint32)__builtin_clz(t_Value);
+#endif
+}
+
+static inline char* Payload(BlockHeader* t_Block)
+{
+	return (char*)t_Block + HeaderSize;
+}
+
+static inline BlockHeader* FromPayload(void* t_Memory)
+{
+	return (BlockHeader*)((char*)t_Memory - HeaderSize);
+}
+
+static inline BlockHeader* NextPhys(BlockHeader* t_Block)
+{
+	return (BlockHeader*)(Payload(t_Block) + t_Block->Size);
+}
+
+static inline FreeLinks& Links(BlockHeader* t_Block)
+{
+	return *(FreeLinks*)Payload(t_Block);
+}
+
+static inline uint32 AdjustSize(size_t t_Size)
+{
+	const size_t size = (t_Size + TLSFHeap::Align - 1) & ~size_t(TLSFHeap::Align - 1);
+	return (uint32)(size < MinBlockSize ? MinBlockSize : size);
+}
+
+static void MappingInsert(uint32 t_Size, uint32& fl, uint32& sl)
+{
+	if (t_Size < TLSFHeap::SmallBlockSize)
+	{
+		fl = 0;
+		sl = t_Size / (TLSFHeap::SmallBlockSize / TLSFHeap::SLCount);
+		return;
+	}
+
+	const uint32 bit = HighestBit(t_Size);
+	sl = (t_Size >> (bit - TLSFHeap::SLCountLog2)) ^ TLSFHeap::SLCount;
+	fl = bit - (TLSFHeap::FLShift - 1);
+}
+
+// @Note: Round the size up to the next list so that any block from the
+// found list is big enough
+static void MappingSearch(uint32 t_Size, uint32& fl, uint32& sl)
+{
+	if (t_Size >= TLSFHeap::SmallBlockSize)
+	{
+		t_Size += (1u << (HighestBit(t_Size) - TLSFHeap::SLCountLog2)) - 1;
+	}
+	MappingInsert(t_Size, fl, sl);
+}
+
+// @Note: The smallest block that MappingSearch finds for a request of
+// t_Size; a new pool for the request has to be at least that big or the
+// search goes right past it
+static uint32 SearchSize(uint32 t_Size)
+{
+	if (t_Size < TLSFHeap::SmallBlockSize) return t_Size;
+
+	const uint32 step = 1u << (HighestBit(t_Size) - TLSFHeap::SLCountLog2);
+	return (t_Size + step - 1) & ~(step - 1);
+}
+
+void TLSFHeap::InsertBlock(BlockHeader* t_Block)
+{
+	uint32 fl, sl;
+	MappingInsert(t_Block->Size, fl, sl);
+
+	BlockHeader* head = Blocks[fl][sl];
+	Links(t_Block).NextFree = head;
+	Links(t_Block).PrevFree = nullptr;
+	if (head) Links(head).PrevFree = t_Block;
+
+	Blocks[fl][sl] = t_Block;
+	FLBitmap |= 1u << fl;
+	SLBitmap[fl] |= 1u << sl;
+
+	FreeSize += t_Block->Size;
+}
+
+void TLSFHeap::RemoveBlock(BlockHeader* t_Block)
+{
+	uint32 fl, sl;
+	MappingInsert(t_Block->Size, fl, sl);
+
+	BlockHeader* next = Links(t_Block).NextFree;
+	BlockHeader* prev = Links(t_Block).PrevFree;
+	if (next) Links(next).PrevFree = prev;
+	if (prev) Links(prev).NextFree = next;
+
+	if (Blocks[fl][sl] == t_Block)
+	{
+		Blocks[fl][sl] = next;
+		if (!next)
+		{
+			SLBitmap[fl] &= ~(1u << sl);
+			if (!SLBitmap[fl]) FLBitmap &= ~(1u << fl);
+		}
+	}
+
+	FreeSize -= t_Block->Size;
+}
+
+BlockHeader* TLSFHeap::FindBlock(uint32 t_Size)
+{
+	uint32 fl, sl;
+	MappingSearch(t_Size, fl, sl);
+	if (fl >= FLCount) return nullptr;
+
+	uint32 slMap = SLBitmap[fl] & (~0u << sl);
+	if (!slMap)
+	{
+		const uint32 flMap = FLBitmap & (~0u << (fl + 1));
+		if (!flMap) return nullptr;
+
+		fl = LowestBit(flMap);
+		slMap = SLBitmap[fl];
+	}
+
+	return Blocks[fl][LowestBit(slMap)];
+}
+
+void TLSFHeap::MergeAndInsert(BlockHeader* t_Block)
+{
+	BlockHeader* prev = t_Block->PrevPhys;
+	if (prev && prev->Free)
+	{
+		RemoveBlock(prev);
+		prev->Size += HeaderSize + t_Block->Size;
+		t_Block = prev;
+	}
+
+	BlockHeader* next = NextPhys(t_Block);
+	if (next->Free)
+	{
+		RemoveBlock(next);
+		t_Block->Size += HeaderSize + next->Size;
+	}
+
+	NextPhys(t_Block)->PrevPhys = t_Block;
+	t_Block->Free = 1;
+	InsertBlock(t_Block);
+}
+
+void TLSFHeap::AddPool(size_t t_Size)
+{
+	size_t poolSize = t_Size + 2 * HeaderSize;
+	poolSize = poolSize < DefaultPoolSize ? DefaultPoolSize : poolSize;
+	poolSize = (poolSize + Align - 1) & ~size_t(Align - 1);
+
+	// @Note: A budget might not have room for a whole default pool
+	if (Owner != Tag_Unknown)
+	{
+		auto& region = Memory::g_Memory.Budgets[Owner].Region;
+		const size_t free = region.MaxSize - region.Size;
+		const size_t remaining = free > Align ? (free - Align) & ~size_t(Align - 1) : 0;
+		const size_t required = (t_Size + 2 * HeaderSize + Align - 1) & ~size_t(Align - 1);
+		poolSize = poolSize > remaining ? (remaining > required ? remaining : required) : poolSize;
+	}
+
+	// @Note: If nothing else took memory from the region since the last
+	// pool, the new pool continues the old one and the old end sentinel
+	// becomes the header of the new free block
+	char* memory = (char*)Memory::HeapPoolGet(Owner, poolSize, Align);
+	const bool continuous = memory == LastPoolEnd;
+
+	BlockHeader* block;
+	if (continuous)
+	{
+		block = (BlockHeader*)(memory - HeaderSize);
+		block->Size = (uint32)(poolSize - HeaderSize);
+	}
+	else
+	{
+		block = (BlockHeader*)memory;
+		block->PrevPhys = nullptr;
+		block->Size = (uint32)(poolSize - 2 * HeaderSize);
+		++PoolsCount;
+	}
+
+	block->Tag = 0;
+	block->Slack = 0;
+
+	BlockHeader* sentinel = (BlockHeader*)(memory + poolSize - HeaderSize);
+	sentinel->PrevPhys = block;
+	sentinel->Size = 0;
+	sentinel->Free = 0;
+
+	LastPoolEnd = memory + poolSize;
+	PoolsSize += poolSize;
+
+	MergeAndInsert(block);
+}
+
+// @Note: Give back the end of the block if it is big enough to be a block
+// of its own
+void TLSFHeap::SplitBlock(BlockHeader* t_Block, uint32 t_Size)
+{
+	if (t_Block->Size < t_Size + HeaderSize + MinBlockSize) return;
+
+	BlockHeader* rest = (BlockHeader*)(Payload(t_Block) + t_Size);
+	rest->PrevPhys = t_Block;
+	rest->Size = t_Block->Size - t_Size - HeaderSize;
+	rest->Free = 1;
+	rest->Tag = 0;
+	rest->Slack = 0;
+	NextPhys(rest)->PrevPhys = rest;
+
+	t_Block->Size = t_Size;
+	InsertBlock(rest);
+}
+
+void* TLSFHeap::Alloc(size_t t_Size, SystemTag t_Tag, size_t t_Align)
+{
+	Assert(t_Size < Megabytes(512), "Allocation is too big for the heap: {}", t_Size);
+
+	const uint32 size = AdjustSize(t_Size);
+
+	// @Note: The payloads are always aligned to Align; for anything
+	// bigger look for a block with enough room to cut a free block off
+	// its front
+	const uint32 gap = t_Align > Align ? (uint32)(t_Align + HeaderSize + MinBlockSize) : 0;
+
+	BlockHeader* block = FindBlock(size + gap);
+	if (!block)
+	{
+		AddPool(SearchSize(size + gap));
+		block = FindBlock(size + gap);
+	}
+	Assert(block, "The heap can't find a free block of size {}", size);
+	if (!block) return nullptr;
+
+	RemoveBlock(block);
+
+	size_t padding = gap ? AlignmentPadding(Payload(block), t_Align) : 0;
+	if (padding)
+	{
+		while (padding < HeaderSize + MinBlockSize) padding += t_Align;
+
+		BlockHeader* aligned = (BlockHeader*)(Payload(block) + padding - HeaderSize);
+		aligned->PrevPhys = block;
+		aligned->Size = block->Size - (uint32)padding;
+		NextPhys(aligned)->PrevPhys = aligned;
+
+		// @Note: The block before a free block is never free so the cut
+		// off part can go straight into the free lists
+		block->Size = (uint32)padding - HeaderSize;
+		InsertBlock(block);
+
+		block = aligned;
+	}
+
+	SplitBlock(block, size);
+
+	block->Free = 0;
+	block->Tag = (uint8)t_Tag;
+	block->Slack = (uint16)(block->Size - t_Size);
+
+	const uint64 used = block->Size + HeaderSize;
+	auto& stats = Stats[t_Tag];
+	stats.Requested += t_Size;
+	stats.Used += used;
+	stats.Allocations += 1;
+	stats.PeakUsed = stats.Used > stats.PeakUsed ? stats.Used : stats.PeakUsed;
+	Telemetry::AddMemory(t_Tag, used);
+
+	return Payload(block);
+}
+
+void TLSFHeap::Free(void* t_Memory)
+{
+	if (!t_Memory) return;
+
+	BlockHeader* block = FromPayload(t_Memory);
+	Assert(!block->Free, "Freeing heap memory that is already free");
+
+	const uint64 used = block->Size + HeaderSize;
+	auto& stats = Stats[block->Tag];
+	stats.Requested -= block->Size - block->Slack;
+	stats.Used -= used;
+	stats.Allocations -= 1;
+	Telemetry::RemoveMemory((SystemTag)block->Tag, used);
+
+	MergeAndInsert(block);
+}
+
+bool TLSFHeap::Expand(void* t_Memory, size_t t_Size)
+{
+	BlockHeader* block = FromPayload(t_Memory);
+	Assert(!block->Free, "Expanding heap memory that is free");
+
+	const uint32 size = AdjustSize(t_Size);
+	const uint64 oldUsed = block->Size + HeaderSize;
+	const uint32 oldRequested = block->Size - block->Slack;
+
+	if (block->Size < size)
+	{
+		BlockHeader* next = NextPhys(block);
+		if (!next->Free || block->Size + HeaderSize + next->Size < size) return false;
+
+		RemoveBlock(next);
+		block->Size += HeaderSize + next->Size;
+		NextPhys(block)->PrevPhys = block;
+
+		SplitBlock(block, size);
+	}
+
+	block->Slack = (uint16)(block->Size - t_Size);
+
+	const uint64 used = block->Size + HeaderSize;
+	auto& stats = Stats[block->Tag];
+	stats.Requested += t_Size - oldRequested;
+	stats.Used += used - oldUsed;
+	stats.PeakUsed = stats.Used > stats.PeakUsed ? stats.Used : stats.PeakUsed;
+	Telemetry::AddMemory((SystemTag)block->Tag, used - oldUsed);
+
+	return true;
+}
+
+size_t TLSFHeap::BlockSize(void* t_Memory)
+{
+	return FromPayload(t_Memory)->Size;
+}
+
+SystemTag TLSFHeap::BlockTag(void* t_Memory)
+{
+	return (SystemTag)FromPayload(t_Memory)->Tag;
+}
+
+size_t TLSFHeap::LargestFreeBlock()
+{
+	if (!FLBitmap) return 0;
+
+	const uint32 fl = HighestBit(FLBitmap);
+	const uint32 sl = HighestBit(SLBitmap[fl]);
+
+	size_t largest = 0;
+	for (BlockHeader* block = Blocks[fl][sl]; block; block = Links(block).NextFree)
+	{
+		largest = block->Size > largest ? block->Size : largest;
+	}
+	return largest;
+}
+
+float TLSFHeap::Fragmentation()
+{
+	if (FreeSize == 0) return 0.0f;
+	return 1.0f - (float)LargestFreeBlock() / (float)FreeSize;
+}
+
+// @Note: The heap operations are short so a plain spin lock is enough;
+// most of the time nobody else is even close to the heap
+static TLSFHeap* LockHeap(TLSFHeap* t_Heap)
+{
+	TLSFHeap* heap = t_Heap ? t_Heap : &Memory::g_Heap;
+	while (heap->Lock.exchange(true, std::memory_order_acquire)) {}
+	return heap;
+}
+
+static void UnlockHeap(TLSFHeap* t_Heap)
+{
+	t_Heap->Lock.store(false, std::memory_order_release);
+}
+
+void* Memory::HeapAlloc(size_t t_Size, SystemTag Tag, size_t t_Align)
+{
+	TLSFHeap* heap = LockHeap(g_Memory.Budgets[Tag].Heap);
+	void* memory = heap->Alloc(t_Size, Tag, t_Align);
+	UnlockHeap(heap);
+	return memory;
+}
+
+void Memory::HeapFree(void* t_Memory)
+{
+	if (!t_Memory) return;
+
+	TLSFHeap* heap = LockHeap(g_Memory.Budgets[TLSFHeap::BlockTag(t_Memory)].Heap);
+	heap->Free(t_Memory);
+	UnlockHeap(heap);
+}
+
+bool Memory::HeapExpand(void* t_Memory, size_t t_Size)
+{
+	TLSFHeap* heap = LockHeap(g_Memory.Budgets[TLSFHeap::BlockTag(t_Memory)].Heap);
+	const bool expanded = heap->Expand(t_Memory, t_Size);
+	UnlockHeap(heap);
+	return expanded;
+}
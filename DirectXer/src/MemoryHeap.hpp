@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Tags.hpp>
+#include <Utils.hpp>
+
+#include <atomic>
+
+/*
+  @Note: Two-level segregated fit heap; this is the general purpose
+  allocator of the engine for things that can actually be freed
+  (vectors that regrow, hash tables that rehash, etc.). Both the
+  allocation and the freeing are O(1) -- the free blocks are kept in
+  lists bucketed by size; the first level splits the sizes in powers of
+  two and the second level splits each power of two in SLCount linear
+  steps. Two bitmaps tell which of the lists are not empty so finding a
+  fitting block is just a couple of bit scans.
+
+  The heap does not own any memory by itself; it gets pools of memory
+  from the heap region (or from the budget of its owner) whenever it runs
+  out of space. Pools that end up next to each other are merged into one.
+*/
+struct TLSFHeap
+{
+	inline static const uint32 AlignLog2 = 4;
+	inline static const uint32 Align = 1u << AlignLog2;
+	inline static const uint32 SLCountLog2 = 5;
+	inline static const uint32 SLCount = 1u << SLCountLog2;
+	inline static const uint32 FLShift = SLCountLog2 + AlignLog2;
+	inline static const uint32 FLMax = 32;
+	inline static const uint32 FLCount = FLMax - FLShift + 1;
+	inline static const uint32 SmallBlockSize = 1u << FLShift;
+
+	inline static const size_t DefaultPoolSize = Megabytes(4);
+
+	struct BlockHeader
+	{
+		BlockHeader* PrevPhys;
+		uint32 Size;
+		uint8 Free;
+		uint8 Tag;
+		// @Note: The difference between the block size and the requested
+		// size; used only for the fragmentation statistics
+		uint16 Slack;
+	};
+
+	// @Note: Only the free blocks have those; they live in the payload
+	struct FreeLinks
+	{
+		BlockHeader* NextFree;
+		BlockHeader* PrevFree;
+	};
+
+	struct TagStats
+	{
+		uint64 Requested;
+		uint64 Used;
+		uint64 Allocations;
+		uint64 PeakUsed;
+	};
+
+	uint32 FLBitmap;
+	uint32 SLBitmap[FLCount];
+	BlockHeader* Blocks[FLCount][SLCount];
+
+	char* LastPoolEnd;
+	uint64 PoolsSize;
+	uint64 FreeSize;
+	uint32 PoolsCount;
+
+	TagStats Stats[Tags_Count];
+
+	// @Note: Tag_Unknown for the common heap; a system with a memory
+	// budget has its own heap that lives in the budget
+	SystemTag Owner;
+
+	// @Note: Taken by Memory::HeapAlloc and friends; the containers of the
+	// game state grow from the jobs while the main thread renders
+	std::atomic<bool> Lock;
+
+	void* Alloc(size_t t_Size, SystemTag t_Tag, size_t t_Align = Align);
+	void Free(void* t_Memory);
+
+	// @Note: Grow an allocation without moving it; this works only if the
+	// block after it is free and big enough. Returns false and leaves the
+	// allocation as it was otherwise
+	bool Expand(void* t_Memory, size_t t_Size);
+	size_t BlockSize(void* t_Memory);
+	static SystemTag BlockTag(void* t_Memory);
+
+	// @Note: Size of the biggest free block; the closer it is to
+	// FreeSize, the less fragmented the heap is
+	size_t LargestFreeBlock();
+	float Fragmentation();
+
+  private:
+
+	void AddPool(size_t t_Size);
+	void SplitBlock(BlockHeader* t_Block, uint32 t_Size);
+	void MergeAndInsert(BlockHeader* t_Block);
+	void InsertBlock(BlockHeader* t_Block);
+	void RemoveBlock(BlockHeader* t_Block);
+	BlockHeader* FindBlock(uint32 t_Size);
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <Memory.hpp>
+#include <Timing.hpp>
+#include <Tags.hpp>
+
+#include <new>
+#include <utility>
+
+/*
+  @Note: The pool hands out fixed size slots for objects of a single
+  type; the slots are taken from the bulk memory in slabs and once an
+  object is freed, its slot is put in an intrusive free list and it is
+  reused by the next allocation. The slabs themselves are never given
+  back, so the memory used by the pool is bound by the maximum number
+  of objects that were alive at the same time.
+
+  The bulk memory counter grows with the slabs while the counter for
+  the pool's tag follows the objects that are currently alive.
+*/
+template<typename T, SystemTag Tag>
+struct Memory::Pool
+{
+	union Slot
+	{
+		Slot* Next;
+		alignas(T) char Storage[sizeof(T)];
+	};
+
+	Slot* FreeList;
+	uint32 SlabSlots;
+	size_t Used;
+	size_t Capacity;
+
+	void Init(uint32 t_SlabSlots = 64)
+	{
+		FreeList = nullptr;
+		SlabSlots = t_SlabSlots;
+		Used = 0;
+		Capacity = 0;
+	}
+
+	T* Alloc()
+	{
+		if (!FreeList) Grow();
+
+		Slot* slot = FreeList;
+		FreeList = slot->Next;
+		++Used;
+
+		Telemetry::AddMemory(Tag, sizeof(T));
+		return (T*)slot->Storage;
+	}
+
+	void Free(T* t_Object)
+	{
+		Assert(Used > 0, "Freeing an object from an empty pool");
+
+		Slot* slot = (Slot*)t_Object;
+		slot->Next = FreeList;
+		FreeList = slot;
+		--Used;
+
+		Telemetry::RemoveMemory(Tag, sizeof(T));
+	}
+
+	template<typename ... Args>
+	T* New(Args&& ... t_Args)
+	{
+		return new(Alloc()) T(std::forward<Args>(t_Args)...);
+	}
+
+	void Delete(T* t_Object)
+	{
+		t_Object->~T();
+		Free(t_Object);
+	}
+
+  private:
+
+	void Grow()
+	{
+		Assert(SlabSlots > 0, "The pool is not initialized");
+
+		// @Note: The slab is not given the tag of the pool; only the live
+		// objects count towards it
+		Slot* slab = (Slot*)Memory::BulkGet(SlabSlots * sizeof(Slot), Tag_Unknown, alignof(Slot));
+		for (uint32 i = 0; i < SlabSlots; ++i)
+		{
+			slab[i].Next = i + 1 < SlabSlots ? &slab[i + 1] : FreeList;
+		}
+
+		FreeList = slab;
+		Capacity += SlabSlots;
+	}
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Utils.hpp>
+#include <Config.hpp>
+#include <Memory.hpp>
+#include <Jobs.hpp>
+
+#include <type_traits>
+
+/*
+  @Note: Loops over ranges that are split into chunks of (at most) t_Grain
+  elements; every chunk is a job. The body of a loop gets the begin and the
+  end of its chunk so that it can keep its own loop as tight as it was.
+
+  The chunks depend only on the count and the grain -- never on the number
+  of threads -- and the partial results of the chunks are combined in the
+  order of the chunks on the calling thread. The results of ParallelReduce
+  and ParallelScan are thus the same on every run and on every machine,
+  even for floating point sums.
+
+  A loop never starts more than MaxChunks jobs; the chunks of a bigger
+  one are merged into longer ones. That also depends only on the count and
+  the grain.
+
+  The partials live in the temporary memory of the calling thread. If the
+  range fits in a single chunk or there is nobody to help (no job system
+  on this thread or a single thread), everything runs inline.
+*/
+
+namespace detail
+{
+
+// @Note: Well below the jobs that a worker can have in flight so that the
+// loops started from inside of jobs have room as well
+inline static const size_t MaxChunks = JobSystem::JobsPerWorker / 16;
+
+inline size_t ChunkGrain(size_t t_Count, size_t t_Grain)
+{
+	const size_t chunks = (t_Count + t_Grain - 1) / t_Grain;
+	return chunks <= MaxChunks ? t_Grain : (t_Count + MaxChunks - 1) / MaxChunks;
+}
+
+inline size_t ChunksCount(size_t t_Count, size_t t_Grain)
+{
+	const size_t grain = ChunkGrain(t_Count, t_Grain);
+	return (t_Count + grain - 1) / grain;
+}
+
+inline bool RunInline(size_t t_Chunks)
+{
+	return t_Chunks <= 1 || !JobSystem::g_Worker || JobSystem::ThreadsCount() <= 1;
+}
+
+// @Note: Runs t_Chunk(chunkIndex, begin, end) for every chunk and waits for all of them
+template<class ChunkFunction>
+void ForEachChunk(size_t t_Count, size_t t_Grain, const ChunkFunction& t_Chunk)
+{
+	t_Grain = ChunkGrain(t_Count, t_Grain);
+	const size_t chunks = ChunksCount(t_Count, t_Grain);
+	if (RunInline(chunks))
+	{
+		for (size_t i = 0; i < chunks; ++i)
+		{
+			const size_t begin = i * t_Grain;
+			t_Chunk(i, begin, begin + t_Grain < t_Count ? begin + t_Grain : t_Count);
+		}
+		return;
+	}
+
+	// @Note: The jobs only point to the function; it stays alive on this
+	// stack until all of them are done
+	const ChunkFunction* chunk = &t_Chunk;
+	JobCounter counter;
+	for (size_t i = 0; i < chunks; ++i)
+	{
+		const size_t begin = i * t_Grain;
+		const size_t end = begin + t_Grain < t_Count ? begin + t_Grain : t_Count;
+		JobSystem::Run(counter, [chunk, i, begin, end]() { (*chunk)(i, begin, end); });
+	}
+	JobSystem::Wait(counter);
+}
+
+// @Note: Each partial is on its own cache line so the chunks don't fight over them
+template<class T>
+struct alignas(CacheLineSize) Partial
+{
+	T Value;
+};
+
+}
+
+// @Note: t_Body(begin, end) is called for every chunk of [0, t_Count)
+template<class Body>
+void ParallelFor(size_t t_Count, size_t t_Grain, const Body& t_Body)
+{
+	Assert(t_Grain > 0, "The grain of a parallel loop can't be zero");
+	if (t_Count == 0) return;
+
+	detail::ForEachChunk(t_Count, t_Grain, [&t_Body](size_t, size_t t_Begin, size_t t_End) { t_Body(t_Begin, t_End); });
+}
+
+// @Note: t_Map(begin, end) reduces a chunk to a single value and
+// t_Combine(left, right) combines two of those; the chunks are combined
+// from left to right starting with t_Identity
+template<class T, class Map, class Combine>
+T ParallelReduce(size_t t_Count, size_t t_Grain, T t_Identity, const Map& t_Map, const Combine& t_Combine)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "The partials of a parallel reduce must be trivially copyable");
+	Assert(t_Grain > 0, "The grain of a parallel reduce can't be zero");
+	if (t_Count == 0) return t_Identity;
+
+	Memory::EstablishTempScope();
+	Defer {
+		Memory::EndTempScope();
+	};
+
+	const size_t chunks = detail::ChunksCount(t_Count, t_Grain);
+	auto* partials = (detail::Partial<T>*)Memory::TempAlloc(chunks * sizeof(detail::Partial<T>), alignof(detail::Partial<T>));
+
+	detail::ForEachChunk(t_Count, t_Grain, [partials, &t_Map](size_t t_Chunk, size_t t_Begin, size_t t_End) {
+		partials[t_Chunk].Value = t_Map(t_Begin, t_End);
+	});
+
+	T result = t_Identity;
+	for (size_t i = 0; i < chunks; ++i) result = t_Combine(result, partials[i].Value);
+	return result;
+}
+
+// @Note: Inclusive scan; t_Out[i] is t_Identity combined with t_In[0..i].
+// The input and the output may be the same array. The chunks are first
+// summed up, the sums are scanned on the calling thread and then every
+// chunk scans itself starting from the sum of the chunks before it
+template<class T, class Combine>
+void ParallelScan(const T* t_In, T* t_Out, size_t t_Count, size_t t_Grain, T t_Identity, const Combine& t_Combine)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "The partials of a parallel scan must be trivially copyable");
+	Assert(t_Grain > 0, "The grain of a parallel scan can't be zero");
+	if (t_Count == 0) return;
+
+	Memory::EstablishTempScope();
+	Defer {
+		Memory::EndTempScope();
+	};
+
+	const size_t chunks = detail::ChunksCount(t_Count, t_Grain);
+	auto* partials = (detail::Partial<T>*)Memory::TempAlloc(chunks * sizeof(detail::Partial<T>), alignof(detail::Partial<T>));
+
+	detail::ForEachChunk(t_Count, t_Grain, [partials, t_In, t_Identity, &t_Combine](size_t t_Chunk, size_t t_Begin, size_t t_End) {
+		T sum = t_Identity;
+		for (size_t i = t_Begin; i < t_End; ++i) sum = t_Combine(sum, t_In[i]);
+		partials[t_Chunk].Value = sum;
+	});
+
+	T offset = t_Identity;
+	for (size_t i = 0; i < chunks; ++i)
+	{
+		const T sum = partials[i].Value;
+		partials[i].Value = offset;
+		offset = t_Combine(offset, sum);
+	}
+
+	detail::ForEachChunk(t_Count, t_Grain, [partials, t_In, t_Out, &t_Combine](size_t t_Chunk, size_t t_Begin, size_t t_End) {
+		T sum = partials[t_Chunk].Value;
+		for (size_t i = t_Begin; i < t_End; ++i)
+		{
+			sum = t_Combine(sum, t_In[i]);
+			t_Out[i] = sum;
+		}
+	});
+}
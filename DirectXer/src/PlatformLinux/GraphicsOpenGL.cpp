@@ -216,6 +216,39 @@ void GraphicsOpenGL::EndFrame()
 
 }
 
+void GraphicsOpenGL::DestroyTexture(TextureId id)
+{
+	auto tex = Textures.erase_at(id);
+	ReleaseTextureId(id);
+	glDeleteTextures(1, &tex.texture);
+}
+
+void GraphicsOpenGL::DestroyCubeTexture(TextureId id)
+{
+	DestroyTexture(id);
+}
+
+void GraphicsOpenGL::DestroyVertexBuffer(VertexBufferId id)
+{
+	auto buf = VertexBuffers.erase_at(id);
+	ReleaseVertexBufferId(id);
+	glDeleteBuffers(1, &buf.vbo);
+}
+
+void GraphicsOpenGL::DestroyIndexBuffer(IndexBufferId id)
+{
+	auto buf = IndexBuffers.erase_at(id);
+	ReleaseIndexBufferId(id);
+	glDeleteBuffers(1, &buf.vio);
+}
+
+void GraphicsOpenGL::DestroyConstantBuffer(ConstantBufferId id)
+{
+	auto buf = ConstantBuffers.erase_at(id);
+	ReleaseConstantBufferId(id);
+	glDeleteBuffers(1, &buf.cbo);
+}
+
 void GraphicsOpenGL::DestroyZBuffer()
 {
 
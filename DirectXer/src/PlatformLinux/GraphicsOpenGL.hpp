@@ -135,6 +135,12 @@ class GraphicsOpenGL
 	void ClearRT(RTObject& t_RT);
 	void EndFrame();
 
+	void DestroyTexture(TextureId id);
+	void DestroyCubeTexture(TextureId id);
+	void DestroyVertexBuffer(VertexBufferId id);
+	void DestroyIndexBuffer(IndexBufferId id);
+	void DestroyConstantBuffer(ConstantBufferId id);
+
 	void DestroyZBuffer();
 	void Destroy();
 
@@ -2,6 +2,7 @@
 #include <Memory.hpp>
 #include <Resources.hpp>
 #include <App.hpp>
+#include <Jobs.hpp>
 
 
 extern App* InitMain(char** argv, int argc);
@@ -23,5 +24,7 @@ int main(int argc, char** argv)
 
     LinuxPlatformLayer::WriteStdOut("Hello linux\n", strlen("Hello linux"));
     
-    return window.Run();
+    const int result = window.Run();
+    JobSystem::Shutdown();
+    return result;
 }
@@ -29,6 +29,37 @@ void* LinuxPlatformLayer::Allocate(size_t t_Size)
     return (void*)mmap(NULL, t_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, 0, 0);
 }
 
+void* LinuxPlatformLayer::Reserve(size_t t_Size, bool t_HugePages)
+{
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+
+    if (!t_HugePages)
+    {
+        void* memory = mmap(NULL, t_Size, PROT_NONE, flags, -1, 0);
+        return memory == MAP_FAILED ? nullptr : memory;
+    }
+
+    // @Note: We go with transparent huge pages; MAP_HUGETLB with
+    // MAP_NORESERVE "succeeds" even without a hugetlb pool and then
+    // crashes on the first touch. Transparent huge pages need 2MB aligned
+    // ranges so reserve a bit more and trim the edges
+    const size_t hugePage = Megabytes(2);
+    char* raw = (char*)mmap(NULL, t_Size + hugePage, PROT_NONE, flags, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+
+    char* aligned = (char*)(((size_t)raw + hugePage - 1) & ~(hugePage - 1));
+    if (aligned != raw) munmap(raw, aligned - raw);
+    munmap(aligned + t_Size, (raw + hugePage) - aligned);
+
+    madvise(aligned, t_Size, MADV_HUGEPAGE);
+    return aligned;
+}
+
+bool LinuxPlatformLayer::Commit(void* t_Memory, size_t t_Size)
+{
+    return mprotect(t_Memory, t_Size, PROT_READ | PROT_WRITE) == 0;
+}
+
 LinuxPlatformLayer::FileHandle LinuxPlatformLayer::OpenFileForReading(const char* t_Path)
 {
     int fd = open(t_Path, O_RDONLY, S_IRUSR | S_IWUSR);
@@ -97,7 +128,7 @@ int LinuxWindow::Run()
 	{
 		XNextEvent(X11Display, &NextEvent);
 
-		if (e.type == KeyPress) break;
+		if (NextEvent.type == KeyPress) break;
 
 	}
 	
@@ -6,6 +6,7 @@
 #include "IncludeLinux.hpp"
 
 struct MemoryArena;
+class App;
 struct LinuxPlatformLayer
 {
     using FileHandle = int;
@@ -39,6 +40,8 @@ struct LinuxPlatformLayer
 	static void WriteStdOut(const char* data, size_t len);
 	static void WriteErrOut(const char* data, size_t len);
 	static void* Allocate(size_t t_Size);
+	static void* Reserve(size_t t_Size, bool t_HugePages);
+	static bool Commit(void* t_Memory, size_t t_Size);
 	static FileHandle OpenFileForReading(const char* t_Path);
 	static size_t FileSize(FileHandle handle);
 	static void ReadFileIntoArena(FileHandle handle, size_t size, MemoryArena& t_Arena);
@@ -524,9 +524,10 @@ void GraphicsD3D11::SetConstantBufferName(ConstantBufferId id, String name)
 	obj.id->SetPrivateData(WKPDID_D3DDebugObjectName, (uint32)name.size(), name.data());
 }
 
-void GraphicsD3D11::DestroyCubeTexture(TextureId id)
+void GraphicsD3D11::DestroyTexture(TextureId id)
 {
 	auto tex = Textures.erase_at(id);
+	ReleaseTextureId(id);
 
 	tex.tp->Release();
 	if (tex.srv) tex.srv->Release();
@@ -534,21 +535,29 @@ void GraphicsD3D11::DestroyCubeTexture(TextureId id)
 	if (tex.dsv) tex.dsv->Release();
 }
 
+void GraphicsD3D11::DestroyCubeTexture(TextureId id)
+{
+	DestroyTexture(id);
+}
+
 void GraphicsD3D11::DestroyVertexBuffer(VertexBufferId id)
 {
 	auto buf = VertexBuffers.erase_at(id);
+	ReleaseVertexBufferId(id);
 	buf.id->Release();
 }
 
 void GraphicsD3D11::DestroyIndexBuffer(IndexBufferId id)
 {
 	auto buf = IndexBuffers.erase_at(id);
+	ReleaseIndexBufferId(id);
 	buf.id->Release();
 }
 
 void GraphicsD3D11::DestroyConstantBuffer(ConstantBufferId id)
 {
 	auto buf = ConstantBuffers.erase_at(id);
+	ReleaseConstantBufferId(id);
 	buf.id->Release();
 }
 
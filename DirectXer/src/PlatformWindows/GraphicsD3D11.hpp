@@ -114,6 +114,7 @@ class GraphicsD3D11
 	bool CreateIndexBuffer(IndexBufferId id, void* data, uint32 dataSize, bool dynamic = false);
 	bool CreateConstantBuffer(ConstantBufferId id, uint32 t_Size, void* t_InitData);
 
+	void DestroyTexture(TextureId id);
 	void DestroyCubeTexture(TextureId id);
     void DestroyVertexBuffer(VertexBufferId id);
 	void DestroyIndexBuffer(IndexBufferId id);
@@ -3,6 +3,7 @@
 #include <Glm.hpp>
 #include <Logging.hpp>
 #include <Timing.hpp>
+#include <Jobs.hpp>
 
 #include <imgui.h>
 #include <imgui_impl_win32.h>
@@ -42,6 +43,20 @@ void* WindowsPlatformLayer::Allocate(size_t t_Size)
 	return VirtualAlloc(NULL, t_Size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
 }
 
+void* WindowsPlatformLayer::Reserve(size_t t_Size, bool)
+{
+	// @Note: Large pages on Windows need the "Lock pages in memory"
+	// privilege and have to be committed together with the reservation,
+	// which defeats the point of commiting on demand; so we ignore the
+	// huge pages option here
+	return VirtualAlloc(NULL, t_Size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool WindowsPlatformLayer::Commit(void* t_Memory, size_t t_Size)
+{
+	return VirtualAlloc(t_Memory, t_Size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
 uint64 WindowsPlatformLayer::Clock()
 {
 	ULONGLONG lpInterruptTimePrecise;
@@ -402,6 +417,7 @@ void WindowsWindow::Deinit()
 
 	gDxgiManager.Destroy();
 	Application->Graphics.Destroy();
+	JobSystem::Shutdown();
 	OPTICK_SHUTDOWN();
 	
 	UnregisterClass("DirectXer Window", GetModuleHandleA(NULL));
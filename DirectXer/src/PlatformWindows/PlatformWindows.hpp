@@ -94,6 +94,8 @@ struct WindowsPlatformLayer
 	static void WriteStdOut(const char* data, size_t len);
 	static void WriteErrOut(const char* data, size_t len);
 	static void* Allocate(size_t t_Size);
+	static void* Reserve(size_t t_Size, bool t_HugePages);
+	static bool Commit(void* t_Memory, size_t t_Size);
 	static FileHandle OpenFileForReading(const char* t_Path);
 	static FileHandle OpenFileForWriting(const char* t_Path);
 	static size_t FileSize(FileHandle handle);
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Utils.hpp>
+#include <Tags.hpp>
+#include <Config.hpp>
+#include <Memory.hpp>
+
+#include <atomic>
+#include <type_traits>
+
+/*
+  @Note: Bounded queues for passing data between threads. Both of them take
+  their ring from the bulk memory once, in Init, and never allocate again;
+  the capacity is rounded up to a power of two. Push returns false when the
+  queue is full and Pop returns false when it is empty -- neither of them
+  ever blocks, what to do in those cases is up to the caller.
+
+  The indices that the different sides write live on their own cache lines
+  so that the producers and the consumers don't keep stealing the same line
+  from each other.
+*/
+
+// @Note: Exactly one thread pushes and exactly one thread pops; both sides
+// are wait-free. Each side keeps a copy of the index of the other side and
+// only reads the shared one when the copy says that the queue is full
+// (or empty)
+template<class T, SystemTag Tag = Tag_Unknown>
+struct SPSCQueue
+{
+	static_assert(std::is_trivially_copyable_v<T>, "The queues can only hold trivially copyable types");
+
+	alignas(CacheLineSize) std::atomic<size_t> Tail;
+	size_t CachedHead;
+
+	alignas(CacheLineSize) std::atomic<size_t> Head;
+	size_t CachedTail;
+
+	alignas(CacheLineSize) T* Items;
+	size_t Mask;
+
+	void Init(size_t t_Capacity)
+	{
+		size_t capacity = 2;
+		while (capacity < t_Capacity) capacity *= 2;
+
+		Items = (T*)Memory::BulkGet(capacity * sizeof(T), Tag, alignof(T) > CacheLineSize ? alignof(T) : CacheLineSize);
+		Mask = capacity - 1;
+		Tail.store(0, std::memory_order_relaxed);
+		Head.store(0, std::memory_order_relaxed);
+		CachedHead = 0;
+		CachedTail = 0;
+	}
+
+	size_t Capacity() const { return Mask + 1; }
+
+	bool Push(const T& t_Item)
+	{
+		const size_t tail = Tail.load(std::memory_order_relaxed);
+		if (tail - CachedHead > Mask)
+		{
+			CachedHead = Head.load(std::memory_order_acquire);
+			if (tail - CachedHead > Mask) return false;
+		}
+
+		Items[tail & Mask] = t_Item;
+		Tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool Pop(T& t_Item)
+	{
+		const size_t head = Head.load(std::memory_order_relaxed);
+		if (head == CachedTail)
+		{
+			CachedTail = Tail.load(std::memory_order_acquire);
+			if (head == CachedTail) return false;
+		}
+
+		t_Item = Items[head & Mask];
+		Head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// @Note: Only a hint when called from the side that does not own it
+	size_t Size() const
+	{
+		return Tail.load(std::memory_order_acquire) - Head.load(std::memory_order_acquire);
+	}
+};
+
+// @Note: Any number of producers and consumers. Each cell carries a
+// sequence number that says whose turn it is -- a producer can fill the
+// cell at position P when its sequence is P and a consumer can empty it
+// when the sequence is P + 1. A side claims a position with a single CAS
+// and then works on its cell without touching the other cells (D. Vyukov's
+// bounded MPMC queue)
+template<class T, SystemTag Tag = Tag_Unknown>
+struct MPMCQueue
+{
+	static_assert(std::is_trivially_copyable_v<T>, "The queues can only hold trivially copyable types");
+
+	struct Cell
+	{
+		std::atomic<size_t> Sequence;
+		T Data;
+	};
+
+	alignas(CacheLineSize) std::atomic<size_t> EnqueuePos;
+	alignas(CacheLineSize) std::atomic<size_t> DequeuePos;
+	alignas(CacheLineSize) Cell* Cells;
+	size_t Mask;
+
+	void Init(size_t t_Capacity)
+	{
+		size_t capacity = 2;
+		while (capacity < t_Capacity) capacity *= 2;
+
+		Cells = (Cell*)Memory::BulkGet(capacity * sizeof(Cell), Tag, alignof(Cell) > CacheLineSize ? alignof(Cell) : CacheLineSize);
+		Mask = capacity - 1;
+		for (size_t i = 0; i < capacity; ++i)
+		{
+			new (&Cells[i].Sequence) std::atomic<size_t>(i);
+		}
+		EnqueuePos.store(0, std::memory_order_relaxed);
+		DequeuePos.store(0, std::memory_order_relaxed);
+	}
+
+	size_t Capacity() const { return Mask + 1; }
+
+	bool Push(const T& t_Item)
+	{
+		size_t pos = EnqueuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true)
+		{
+			cell = &Cells[pos & Mask];
+			const size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+			const intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+			if (diff == 0)
+			{
+				if (EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = EnqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->Data = t_Item;
+		cell->Sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool Pop(T& t_Item)
+	{
+		size_t pos = DequeuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true)
+		{
+			cell = &Cells[pos & Mask];
+			const size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+			const intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+			if (diff == 0)
+			{
+				if (DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = DequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		t_Item = cell->Data;
+		cell->Sequence.store(pos + Mask + 1, std::memory_order_release);
+		return true;
+	}
+};
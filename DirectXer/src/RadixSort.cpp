@@ -0,0 +1,168 @@
+#include <RadixSort.hpp>
+#include <Memory.hpp>
+#include <Logging.hpp>
+#include <Utils.hpp>
+#include <Parallel.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+static const uint32 RadixBits = 8;
+static const uint32 RadixSize = 1u << RadixBits;
+static const uint32 PassesCount = 64 / RadixBits;
+
+using Histograms = uint32[PassesCount][RadixSize];
+
+static inline uint32 Digit(uint64 t_Key, uint32 t_Pass)
+{
+	return uint32(t_Key >> (t_Pass * RadixBits)) & (RadixSize - 1);
+}
+
+static void BuildHistograms(const SortItem* t_Items, size_t t_Count, Histograms& t_Histograms)
+{
+	std::memset(t_Histograms, 0, sizeof(Histograms));
+	for (size_t i = 0; i < t_Count; ++i)
+	{
+		const uint64 key = t_Items[i].Key;
+		for (uint32 pass = 0; pass < PassesCount; ++pass)
+		{
+			++t_Histograms[pass][Digit(key, pass)];
+		}
+	}
+}
+
+// @Note: A pass is not needed if all of the keys have the same digit in it
+static bool PassNeeded(const uint32* t_Histogram, size_t t_Count)
+{
+	for (uint32 i = 0; i < RadixSize; ++i)
+	{
+		if (t_Histogram[i] == t_Count) return false;
+		if (t_Histogram[i] != 0) return true;
+	}
+	return true;
+}
+
+void RadixSort::Sort(SortItem* t_Items, size_t t_Count)
+{
+	// @Note: For a handful of items the eight histograms cost more than
+	// the sorting itself
+	if (t_Count < RadixSort::SmallThreshold)
+	{
+		std::stable_sort(t_Items, t_Items + t_Count, [](const SortItem& t_Left, const SortItem& t_Right) { return t_Left.Key < t_Right.Key; });
+		return;
+	}
+
+	Histograms histograms;
+	BuildHistograms(t_Items, t_Count, histograms);
+
+	Memory::EstablishTempScope();
+	Defer {
+		Memory::EndTempScope();
+	};
+
+	SortItem* scratch = (SortItem*)Memory::TempAlloc(t_Count * sizeof(SortItem), alignof(SortItem));
+	SortItem* source = t_Items;
+	SortItem* destination = scratch;
+
+	for (uint32 pass = 0; pass < PassesCount; ++pass)
+	{
+		const uint32* histogram = histograms[pass];
+		if (!PassNeeded(histogram, t_Count)) continue;
+
+		uint32 offsets[RadixSize];
+		uint32 sum = 0;
+		for (uint32 i = 0; i < RadixSize; ++i)
+		{
+			offsets[i] = sum;
+			sum += histogram[i];
+		}
+
+		for (size_t i = 0; i < t_Count; ++i)
+		{
+			destination[offsets[Digit(source[i].Key, pass)]++] = source[i];
+		}
+
+		std::swap(source, destination);
+	}
+
+	if (source != t_Items) std::memcpy(t_Items, source, t_Count * sizeof(SortItem));
+}
+
+void RadixSort::SortParallel(SortItem* t_Items, size_t t_Count)
+{
+	if (t_Count < ParallelThreshold || !JobSystem::g_Worker || JobSystem::ThreadsCount() <= 1)
+	{
+		Sort(t_Items, t_Count);
+		return;
+	}
+
+	Memory::EstablishTempScope();
+	Defer {
+		Memory::EndTempScope();
+	};
+
+	// @Note: Like everywhere in Parallel.hpp the chunks depend only on the
+	// count; the big inputs get bigger chunks instead of more of them
+	size_t grain = ParallelGrain;
+	if ((t_Count + grain - 1) / grain > MaxChunks) grain = (t_Count + MaxChunks - 1) / MaxChunks;
+	const size_t chunks = (t_Count + grain - 1) / grain;
+
+	// @Note: The histograms of all the bytes tell which passes are needed;
+	// the chunks build them in parallel and they are added up here
+	auto* chunkHistograms = (Histograms*)Memory::TempAlloc(chunks * sizeof(Histograms), CacheLineSize);
+	ParallelFor(t_Count, grain, [t_Items, chunkHistograms, grain](size_t t_Begin, size_t t_End) {
+		BuildHistograms(t_Items + t_Begin, t_End - t_Begin, chunkHistograms[t_Begin / grain]);
+	});
+
+	Histograms histograms{};
+	for (size_t chunk = 0; chunk < chunks; ++chunk)
+	{
+		for (uint32 pass = 0; pass < PassesCount; ++pass)
+		{
+			for (uint32 digit = 0; digit < RadixSize; ++digit) histograms[pass][digit] += chunkHistograms[chunk][pass][digit];
+		}
+	}
+
+	using ChunkCounts = uint32[RadixSize];
+	auto* counts = (ChunkCounts*)Memory::TempAlloc(chunks * sizeof(ChunkCounts), CacheLineSize);
+	SortItem* scratch = (SortItem*)Memory::TempAlloc(t_Count * sizeof(SortItem), alignof(SortItem));
+	SortItem* source = t_Items;
+	SortItem* destination = scratch;
+
+	for (uint32 pass = 0; pass < PassesCount; ++pass)
+	{
+		if (!PassNeeded(histograms[pass], t_Count)) continue;
+
+		ParallelFor(t_Count, grain, [source, counts, grain, pass](size_t t_Begin, size_t t_End) {
+			uint32* chunkCounts = counts[t_Begin / grain];
+			std::memset(chunkCounts, 0, sizeof(ChunkCounts));
+			for (size_t i = t_Begin; i < t_End; ++i) ++chunkCounts[Digit(source[i].Key, pass)];
+		});
+
+		// @Note: A chunk puts its items after all of the smaller digits and
+		// after the same digit of the chunks before it; that is what keeps
+		// the sort stable. The counts become the offsets in place
+		uint32 sum = 0;
+		for (uint32 digit = 0; digit < RadixSize; ++digit)
+		{
+			for (size_t chunk = 0; chunk < chunks; ++chunk)
+			{
+				const uint32 count = counts[chunk][digit];
+				counts[chunk][digit] = sum;
+				sum += count;
+			}
+		}
+
+		ParallelFor(t_Count, grain, [source, destination, counts, grain, pass](size_t t_Begin, size_t t_End) {
+			uint32* offsets = counts[t_Begin / grain];
+			for (size_t i = t_Begin; i < t_End; ++i)
+			{
+				destination[offsets[Digit(source[i].Key, pass)]++] = source[i];
+			}
+		});
+
+		std::swap(source, destination);
+	}
+
+	if (source != t_Items) std::memcpy(t_Items, source, t_Count * sizeof(SortItem));
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Types.hpp>
+
+#include <cstddef>
+
+// @Note: The thing that gets sorted; the key decides the order and the
+// payload is usually the index of whatever the key was built for (a draw
+// call, a quad, etc.)
+struct SortItem
+{
+	uint64 Key;
+	uint32 Payload;
+};
+
+/*
+  @Note: LSD radix sort over the keys, one byte per pass. The histograms of
+  all the bytes are built with a single read of the input and the passes
+  of the bytes which are the same for every key are skipped -- sort keys
+  usually leave most of their bits empty so only a few passes really run.
+  The sort is stable. The scratch buffer comes from the temporary memory of
+  the calling thread and is given back before returning.
+*/
+struct RadixSort
+{
+	static void Sort(SortItem* t_Items, size_t t_Count);
+
+	// @Note: Same as Sort but the histograms and the scatter of every pass
+	// are split in chunks that run as jobs (see Parallel.hpp); small inputs
+	// and threads outside of the job system sort inline
+	static void SortParallel(SortItem* t_Items, size_t t_Count);
+
+	inline static const size_t SmallThreshold = 1024;
+	inline static const size_t ParallelThreshold = 1u << 16;
+	inline static const size_t ParallelGrain = 1u << 15;
+	inline static const size_t MaxChunks = 64;
+};
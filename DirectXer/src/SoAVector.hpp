@@ -0,0 +1,144 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Utils.hpp>
+#include <Tags.hpp>
+#include <Config.hpp>
+#include <Memory.hpp>
+#include <Containers.hpp>
+
+#include <tuple>
+#include <utility>
+#include <cstring>
+#include <type_traits>
+
+/*
+  @Note: Vector of records that stores each field in its own column; a loop
+  that touches only the positions of the entities reads only the positions
+  and not everything else around them. All of the columns are in a single
+  heap block and each one starts on a cache line. The columns are also
+  padded to whole cache lines so a SIMD loop over a column can always load
+  full vectors -- the lanes after size() are garbage but readable.
+
+  Removing is swap-remove: the last record takes the place of the removed
+  one so the columns stay dense. The fields are copied around with memcpy
+  so they have to be trivially copyable.
+*/
+template<SystemTag Tag, class... Fields>
+struct TaggedSoAVector
+{
+	static_assert((std::is_trivially_copyable_v<Fields> && ...), "The fields of a SoAVector must be trivially copyable");
+
+	inline static const size_t MinCapacity = 16;
+
+	template<size_t I>
+	using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+	std::tuple<Fields*...> Columns{};
+	void* Block{nullptr};
+	size_t Size{0};
+	size_t Capacity{0};
+
+	TaggedSoAVector() = default;
+	TaggedSoAVector(const TaggedSoAVector&) = delete;
+	TaggedSoAVector& operator=(const TaggedSoAVector&) = delete;
+
+	~TaggedSoAVector()
+	{
+		Memory::HeapFree(Block);
+	}
+
+	size_t size() const { return Size; }
+	size_t capacity() const { return Capacity; }
+	bool empty() const { return Size == 0; }
+	void clear() { Size = 0; }
+
+	template<size_t I>
+	Span<Field<I>> column() { return { std::get<I>(Columns), Size }; }
+
+	template<size_t I>
+	Span<const Field<I>> column() const { return { std::get<I>(Columns), Size }; }
+
+	template<size_t I>
+	Field<I>& get(size_t t_Index) { return std::get<I>(Columns)[t_Index]; }
+
+	template<size_t I>
+	const Field<I>& get(size_t t_Index) const { return std::get<I>(Columns)[t_Index]; }
+
+	// @Note: Returns the index of the new record
+	size_t push_back(const Fields&... t_Values)
+	{
+		if (Size == Capacity) reserve(Capacity ? Capacity * 2 : MinCapacity);
+		Set(Size, std::index_sequence_for<Fields...>{}, t_Values...);
+		return Size++;
+	}
+
+	void pop_back() { --Size; }
+
+	// @Note: The last record is moved into the removed one
+	void swap_remove(size_t t_Index)
+	{
+		--Size;
+		if (t_Index != Size) Move(Size, t_Index, std::index_sequence_for<Fields...>{});
+	}
+
+	void resize(size_t t_Size)
+	{
+		reserve(t_Size);
+		Size = t_Size;
+	}
+
+	void reserve(size_t t_Capacity)
+	{
+		if (t_Capacity <= Capacity) return;
+
+		char* block = (char*)Memory::HeapAlloc(BlockSize(t_Capacity), Tag, CacheLineSize);
+		Relocate(block, t_Capacity, std::index_sequence_for<Fields...>{});
+
+		Memory::HeapFree(Block);
+		Block = block;
+		Capacity = t_Capacity;
+	}
+
+  private:
+
+	template<class T>
+	static size_t ColumnSize(size_t t_Capacity)
+	{
+		return (t_Capacity * sizeof(T) + CacheLineSize - 1) & ~(CacheLineSize - 1);
+	}
+
+	static size_t BlockSize(size_t t_Capacity)
+	{
+		return (ColumnSize<Fields>(t_Capacity) + ...);
+	}
+
+	template<size_t... I>
+	void Set(size_t t_Index, std::index_sequence<I...>, const Fields&... t_Values)
+	{
+		((std::get<I>(Columns)[t_Index] = t_Values), ...);
+	}
+
+	template<size_t... I>
+	void Move(size_t t_From, size_t t_To, std::index_sequence<I...>)
+	{
+		((std::get<I>(Columns)[t_To] = std::get<I>(Columns)[t_From]), ...);
+	}
+
+	template<size_t... I>
+	void Relocate(char* t_Block, size_t t_Capacity, std::index_sequence<I...>)
+	{
+		char* current = t_Block;
+		auto relocate = [this, &current, t_Capacity](auto*& t_Column) {
+			using T = std::remove_reference_t<decltype(*t_Column)>;
+			T* column = (T*)current;
+			if (Size) std::memcpy(column, t_Column, Size * sizeof(T));
+			t_Column = column;
+			current += ColumnSize<T>(t_Capacity);
+		};
+		(relocate(std::get<I>(Columns)), ...);
+	}
+};
+
+template<class... Fields>
+using SoAVector = TaggedSoAVector<Tag_Unknown, Fields...>;
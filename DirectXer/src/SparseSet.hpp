@@ -0,0 +1,144 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Utils.hpp>
+#include <Tags.hpp>
+#include <Memory.hpp>
+#include <Containers.hpp>
+#include <SoAVector.hpp>
+
+// @Note: Stable reference to an object in a SparseSet; the generation of
+// the slot is bumped every time its object is destroyed so an old handle
+// never resolves to the object that reused the slot
+struct SlotHandle
+{
+	uint32 Index;
+	uint32 Generation;
+
+	bool operator==(const SlotHandle& t_Other) const { return Index == t_Other.Index && Generation == t_Other.Generation; }
+	bool operator!=(const SlotHandle& t_Other) const { return !(*this == t_Other); }
+};
+
+/*
+  @Note: Sparse set of objects with the given fields. The objects are kept
+  packed in SoA columns (see SoAVector.hpp) so iterating over them is a
+  linear walk over the dense arrays; the handles go through the sparse
+  array of slots which maps them to the current dense index.
+
+  Creating and destroying are both O(1) -- destroying moves the last object
+  into the hole and fixes the slot of the moved object; nothing else
+  moves. When destroying while iterating, iterate from the back.
+*/
+template<SystemTag Tag, class... Fields>
+struct SparseSet
+{
+	inline static const uint32 InvalidIndex = ~0u;
+
+	struct Slot
+	{
+		uint32 DenseIndex;
+		uint32 Generation;
+	};
+
+	// @Note: The first column is the handle of the object in each dense
+	// index; the fields come after it
+	TaggedSoAVector<Tag, SlotHandle, Fields...> Dense;
+	BulkVector<Slot, Tag> Slots;
+	BulkVector<uint32, Tag> FreeSlots;
+
+	void Init(size_t t_Capacity)
+	{
+		reserve(t_Capacity);
+	}
+
+	// @Note: Room for t_Capacity objects alive at the same time; creating
+	// objects up to that does not allocate
+	void reserve(size_t t_Capacity)
+	{
+		Dense.reserve(t_Capacity);
+		Slots.reserve(t_Capacity);
+		FreeSlots.reserve(t_Capacity);
+	}
+
+	size_t size() const { return Dense.size(); }
+	size_t capacity() const { return Dense.capacity(); }
+	bool empty() const { return Dense.empty(); }
+
+	SlotHandle Create(const Fields&... t_Values)
+	{
+		uint32 index;
+		if (!FreeSlots.empty())
+		{
+			index = FreeSlots.back();
+			FreeSlots.pop_back();
+		}
+		else
+		{
+			index = (uint32)Slots.size();
+			Slots.push_back({ InvalidIndex, 0 });
+		}
+
+		SlotHandle handle{ index, Slots[index].Generation };
+		Slots[index].DenseIndex = (uint32)Dense.push_back(handle, t_Values...);
+		return handle;
+	}
+
+	// @Note: Destroying an object that is already gone does nothing
+	bool Destroy(SlotHandle t_Handle)
+	{
+		if (!Alive(t_Handle)) return false;
+
+		Slot& slot = Slots[t_Handle.Index];
+		const uint32 last = (uint32)Dense.size() - 1;
+		if (slot.DenseIndex != last)
+		{
+			Slots[Dense.template get<0>(last).Index].DenseIndex = slot.DenseIndex;
+		}
+		Dense.swap_remove(slot.DenseIndex);
+
+		slot.DenseIndex = InvalidIndex;
+		slot.Generation += 1;
+		FreeSlots.push_back(t_Handle.Index);
+		return true;
+	}
+
+	bool Alive(SlotHandle t_Handle) const
+	{
+		return t_Handle.Index < Slots.size() && Slots[t_Handle.Index].Generation == t_Handle.Generation
+			&& Slots[t_Handle.Index].DenseIndex != InvalidIndex;
+	}
+
+	uint32 DenseIndex(SlotHandle t_Handle) const
+	{
+		Assert(Alive(t_Handle), "The object of the handle was already destroyed");
+		return Slots[t_Handle.Index].DenseIndex;
+	}
+
+	SlotHandle Handle(size_t t_DenseIndex) const { return Dense.template get<0>(t_DenseIndex); }
+
+	template<size_t I>
+	auto& Get(SlotHandle t_Handle) { return Dense.template get<I + 1>(DenseIndex(t_Handle)); }
+
+	// @Note: Access by dense index; this is what the loops over all of the
+	// objects use
+	template<size_t I>
+	auto& At(size_t t_DenseIndex) { return Dense.template get<I + 1>(t_DenseIndex); }
+
+	template<size_t I>
+	const auto& At(size_t t_DenseIndex) const { return Dense.template get<I + 1>(t_DenseIndex); }
+
+	template<size_t I>
+	auto Column() { return Dense.template column<I + 1>(); }
+
+	void Clear()
+	{
+		for (size_t i = 0; i < Dense.size(); ++i)
+		{
+			Slot& slot = Slots[Handle(i).Index];
+			slot.DenseIndex = InvalidIndex;
+			slot.Generation += 1;
+			FreeSlots.push_back(Handle(i).Index);
+		}
+		Dense.clear();
+	}
+};
@@ -0,0 +1,154 @@
+#include <StringInterning.hpp>
+#include <Logging.hpp>
+
+struct InternedString
+{
+	const char* Data;
+	uint32 Length;
+	uint32 Hash;
+};
+
+// @Note: The table is open addressing with linear probing over the ids;
+// it is kept at most half full and rehashing only needs the stored
+// hashes, never the characters
+struct StringPool
+{
+	inline static const size_t BlockSize = Kilobytes(64);
+	inline static const size_t InitialTableSize = 256;
+
+	BulkVector<InternedString, Memory_Strings> Entries;
+	BulkVector<StringId, Memory_Strings> Table;
+
+	char* BlockCurrent;
+	char* BlockEnd;
+};
+
+static StringPool g_Strings{};
+
+static char* StoreCharacters(String t_String)
+{
+	auto& pool = g_Strings;
+	const size_t size = t_String.size() + 1;
+
+	char* memory;
+	if (size > StringPool::BlockSize / 4)
+	{
+		memory = (char*)Memory::HeapAlloc(size, Memory_Strings, 1);
+	}
+	else
+	{
+		if (size > size_t(pool.BlockEnd - pool.BlockCurrent))
+		{
+			pool.BlockCurrent = (char*)Memory::HeapAlloc(StringPool::BlockSize, Memory_Strings);
+			pool.BlockEnd = pool.BlockCurrent + StringPool::BlockSize;
+		}
+		memory = pool.BlockCurrent;
+		pool.BlockCurrent += size;
+	}
+
+	memcpy(memory, t_String.data(), t_String.size());
+	memory[t_String.size()] = '\0';
+	return memory;
+}
+
+static void InitPool()
+{
+	auto& pool = g_Strings;
+	pool.Entries.reserve(StringPool::InitialTableSize / 2);
+	pool.Table.resize(StringPool::InitialTableSize, Strings::Invalid);
+
+	pool.Entries.push_back({ "", 0, jenkins_hash("", 0) });
+	pool.Table[pool.Entries[0].Hash & (StringPool::InitialTableSize - 1)] = Strings::Empty;
+}
+
+static void GrowTable()
+{
+	auto& pool = g_Strings;
+	const size_t size = pool.Table.size() * 2;
+	pool.Table.assign(size, Strings::Invalid);
+
+	for (StringId id = 0; id < (StringId)pool.Entries.size(); ++id)
+	{
+		size_t slot = pool.Entries[id].Hash & (size - 1);
+		while (pool.Table[slot] != Strings::Invalid) slot = (slot + 1) & (size - 1);
+		pool.Table[slot] = id;
+	}
+}
+
+// @Note: The slot that has the string or the empty slot where it should go
+static size_t FindSlot(String t_String, uint32 t_Hash)
+{
+	auto& pool = g_Strings;
+	const size_t mask = pool.Table.size() - 1;
+
+	size_t slot = t_Hash & mask;
+	while (pool.Table[slot] != Strings::Invalid)
+	{
+		const auto& entry = pool.Entries[pool.Table[slot]];
+		if (entry.Hash == t_Hash && entry.Length == t_String.size() && memcmp(entry.Data, t_String.data(), entry.Length) == 0)
+		{
+			return slot;
+		}
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+StringId Strings::Intern(String t_String)
+{
+	auto& pool = g_Strings;
+	if (pool.Table.empty()) InitPool();
+
+	const uint32 hash = jenkins_hash(t_String.data(), t_String.size());
+	size_t slot = FindSlot(t_String, hash);
+	if (pool.Table[slot] != Invalid) return pool.Table[slot];
+
+	if (2 * (pool.Entries.size() + 1) > pool.Table.size())
+	{
+		GrowTable();
+		slot = FindSlot(t_String, hash);
+	}
+
+	const StringId id = (StringId)pool.Entries.size();
+	pool.Entries.push_back({ StoreCharacters(t_String), (uint32)t_String.size(), hash });
+	pool.Table[slot] = id;
+	return id;
+}
+
+StringId Strings::Find(String t_String)
+{
+	auto& pool = g_Strings;
+	if (pool.Table.empty()) return t_String.empty() ? Empty : Invalid;
+
+	return pool.Table[FindSlot(t_String, jenkins_hash(t_String.data(), t_String.size()))];
+}
+
+String Strings::Get(StringId t_Id)
+{
+	if (t_Id == Empty) return String{};
+
+	Assert(t_Id < g_Strings.Entries.size(), "Not an interned string: {}", t_Id);
+	const auto& entry = g_Strings.Entries[t_Id];
+	return String{ entry.Data, entry.Length };
+}
+
+const char* Strings::CStr(StringId t_Id)
+{
+	if (t_Id == Empty) return "";
+
+	Assert(t_Id < g_Strings.Entries.size(), "Not an interned string: {}", t_Id);
+	return g_Strings.Entries[t_Id].Data;
+}
+
+uint32 Strings::Hash(StringId t_Id)
+{
+	if (g_Strings.Entries.empty()) return jenkins_hash("", 0);
+
+	Assert(t_Id < g_Strings.Entries.size(), "Not an interned string: {}", t_Id);
+	return g_Strings.Entries[t_Id].Hash;
+}
+
+size_t Strings::Count()
+{
+	return g_Strings.Entries.size();
+}
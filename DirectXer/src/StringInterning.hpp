@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Utils.hpp>
+#include <Memory.hpp>
+#include <Containers.hpp>
+
+// @Note: Handle of an interned string; two strings are equal exactly
+// when their ids are. 0 is the empty string
+using StringId = uint32;
+
+/*
+  @Note: Every unique string is stored once and is then known by its
+  id; comparing names becomes comparing integers and looking them up
+  does not allocate anything. The characters are kept null terminated
+  so CStr can be given directly to ImGui and the like. The hash of every
+  string is computed once when it is interned.
+
+  The characters live in big blocks of the heap and never move or go
+  away -- the bulk memory can be rolled back by the level markers so it
+  is not a good place for them. Only for the main thread.
+*/
+struct Strings
+{
+	inline static const StringId Empty = 0;
+	inline static const StringId Invalid = ~0u;
+
+	static StringId Intern(String t_String);
+
+	// @Note: Like Intern but never adds the string; gives back Invalid if
+	// the string was never interned
+	static StringId Find(String t_String);
+
+	static String Get(StringId t_Id);
+	static const char* CStr(StringId t_Id);
+	static uint32 Hash(StringId t_Id);
+	static size_t Count();
+};
@@ -13,12 +13,16 @@ enum SystemTag
 	Phase_Update,
 	Phase_Rendering,
 
+	// @Note: The memory tags are the last ones before Tag_Unknown; the
+	// budgets on the command line are looked up in that range
 	Memory_Bulk,
 	Memory_GameState,
 	Memory_2DRendering,
 	Memory_3DRendering,
 	Memory_GPUResource,
 	Memory_Audio,
+	Memory_Strings,
+	Memory_Jobs,
 
 	Tag_Unknown,
 	Tags_Count,
@@ -41,17 +45,19 @@ static inline const char* gSystemTagNames[] =
 	"3DRendering Memory",
 	"GPUResource Memory",
 	"Audio Memory",
+	"Strings Memory",
+	"Jobs Memory",
 
 	"Unknow",
 };
 
 enum CycleCounterTag : uint32
 {
-	CC_SimdFlatMap_At	= 0,
+	CC_GPUSlotMap_At	= 0,
 	CC_Count,
 };
 
 static inline const char* gCycleCounterTagNames[] =
 {
-	"SimdFlatMap_At",
+	"GPUSlotMap_At",
 };
@@ -0,0 +1,131 @@
+#include <TaskGraph.hpp>
+#include <Timing.hpp>
+
+#include <cstring>
+#include <immintrin.h>
+#if defined(_WIN32)
+#include <intrin.h>
+#endif
+
+TaskId TaskGraph::Add(const char* t_Name, JobFunction t_Function, const void* t_Data, size_t t_Size)
+{
+	Assert(TasksCount < Config::MaxFrameTasks, "A task graph can have only {} tasks", Config::MaxFrameTasks);
+	Assert(t_Size <= Job::DataSize, "The data of the task does not fit in it: {}", t_Size);
+
+	Task& task = Tasks[TasksCount];
+	task.Name = t_Name;
+	task.Function = t_Function;
+	if (t_Size) std::memcpy(task.Data, t_Data, t_Size);
+	task.Dependencies = 0;
+	task.Dependents.clear();
+	task.Start = 0;
+	task.End = 0;
+
+	return TasksCount++;
+}
+
+void TaskGraph::Depends(TaskId t_Task, TaskId t_On)
+{
+	Assert(t_Task < TasksCount, "Unknown task: {}", t_Task);
+	Assert(t_On < t_Task, "A task can only depend on tasks that were added before it");
+
+	Tasks[t_On].Dependents.push_back(t_Task);
+	Tasks[t_Task].Dependencies += 1;
+}
+
+void TaskGraph::Run()
+{
+	DxProfileCode(DxTimedBlock(Phase_Update, "Task graph"));
+	const uint64 start = __rdtsc();
+
+	for (uint32 i = 0; i < TasksCount; ++i)
+	{
+		Tasks[i].Pending.store(Tasks[i].Dependencies, std::memory_order_relaxed);
+	}
+
+	for (uint32 i = 0; i < TasksCount; ++i)
+	{
+		if (Tasks[i].Dependencies == 0) Launch(i);
+	}
+
+	JobSystem::Wait(Counter);
+
+	RecordCriticalPath(__rdtsc() - start);
+}
+
+void TaskGraph::Launch(TaskId t_Task)
+{
+	TaskGraph* graph = this;
+	JobSystem::Run(Counter, [graph, t_Task]() { graph->Execute(t_Task); });
+}
+
+// @Note: The dependents are started before this job is counted as done so
+// the counter of the graph never drops to zero while there are tasks left
+void TaskGraph::Execute(TaskId t_Task)
+{
+	Task& task = Tasks[t_Task];
+
+	task.Start = __rdtsc();
+	task.Function(task.Data);
+	task.End = __rdtsc();
+
+	for (const TaskId dependent : task.Dependents)
+	{
+		if (Tasks[dependent].Pending.fetch_sub(1, std::memory_order_acq_rel) == 1) Launch(dependent);
+	}
+}
+
+// @Note: The tasks are in an order where every task comes after the tasks
+// it depends on, so one pass over them finds the longest chain ending in
+// each one
+void TaskGraph::RecordCriticalPath(uint64 t_GraphCycles)
+{
+	uint64 longest[Config::MaxFrameTasks]{};
+	uint32 previous[Config::MaxFrameTasks];
+
+	Telemetry::TaskGraphStats stats{};
+	stats.GraphCycles = t_GraphCycles;
+
+	for (uint32 i = 0; i < TasksCount; ++i) previous[i] = i;
+
+	uint32 last = 0;
+	for (uint32 i = 0; i < TasksCount; ++i)
+	{
+		const Task& task = Tasks[i];
+		const uint64 cycles = task.End - task.Start;
+		stats.WorkCycles += cycles;
+		longest[i] += cycles;
+
+		for (const TaskId dependent : task.Dependents)
+		{
+			if (longest[i] > longest[dependent])
+			{
+				longest[dependent] = longest[i];
+				previous[dependent] = i;
+			}
+		}
+
+		if (longest[i] > longest[last]) last = i;
+	}
+
+	if (TasksCount == 0)
+	{
+		Telemetry::RecordTaskGraph(stats);
+		return;
+	}
+
+	stats.CriticalPathCycles = longest[last];
+
+	uint32 path[Config::MaxFrameTasks];
+	uint32 length = 0;
+	for (uint32 i = last;; i = previous[i])
+	{
+		path[length++] = i;
+		if (previous[i] == i) break;
+	}
+
+	for (uint32 i = 0; i < length; ++i) stats.CriticalPath[i] = Tasks[path[length - 1 - i]].Name;
+	stats.CriticalPathLength = length;
+
+	Telemetry::RecordTaskGraph(stats);
+}
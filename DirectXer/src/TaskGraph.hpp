@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Utils.hpp>
+#include <Config.hpp>
+#include <Memory.hpp>
+#include <Containers.hpp>
+#include <Jobs.hpp>
+
+#include <atomic>
+#include <type_traits>
+
+using TaskId = uint32;
+
+/*
+  @Note: Graph of the tasks of a frame. The tasks are added together with
+  the tasks they depend on and then the whole graph is run on the job
+  system; a task is started as soon as the last of its dependencies is done
+  so the independent tasks run next to each other.
+
+  A task can only depend on tasks that were added before it; the order of
+  adding is thus always a valid order to run the tasks in and a graph can't
+  have cycles. The graph is meant to be built anew every frame on the stack
+  of the thread that runs it.
+
+  Once the graph has run, the time of each task is known and the longest
+  chain of dependent tasks (the critical path) goes to the telemetry.
+*/
+struct TaskGraph
+{
+	inline static const uint32 MaxDependents = 8;
+
+	struct Task
+	{
+		const char* Name;
+		JobFunction Function;
+		char Data[Job::DataSize];
+		uint32 Dependencies;
+		std::atomic<uint32> Pending;
+		StaticVector<TaskId, MaxDependents> Dependents;
+		uint64 Start;
+		uint64 End;
+	};
+
+	Task Tasks[Config::MaxFrameTasks];
+	uint32 TasksCount{0};
+	JobCounter Counter;
+
+	TaskId Add(const char* t_Name, JobFunction t_Function, const void* t_Data = nullptr, size_t t_Size = 0);
+
+	template<class Function>
+	TaskId Add(const char* t_Name, const Function& t_Function)
+	{
+		static_assert(sizeof(Function) <= Job::DataSize, "The captures of the task don't fit in it");
+		static_assert(std::is_trivially_copyable_v<Function>, "The captures of the task must be trivially copyable");
+		return Add(t_Name, [](void* t_Data) { (*(Function*)t_Data)(); }, &t_Function, sizeof(Function));
+	}
+
+	// @Note: t_Task won't start before t_On is done
+	void Depends(TaskId t_Task, TaskId t_On);
+
+	template<class... Ids>
+	void Depends(TaskId t_Task, TaskId t_On, Ids... t_Others)
+	{
+		Depends(t_Task, t_On);
+		Depends(t_Task, t_Others...);
+	}
+
+	// @Note: Runs every task and returns when all of them are done; has to
+	// be called from a thread of the job system
+	void Run();
+
+  private:
+
+	void Launch(TaskId t_Task);
+	void Execute(TaskId t_Task);
+	void RecordCriticalPath(uint64 t_GraphCycles);
+};
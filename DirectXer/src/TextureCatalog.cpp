@@ -9,7 +9,7 @@ void TextureCatalog::LoadTextures(Graphics& graphics)
 	MemoryArena fileArena = Memory::GetTempArena(Megabytes(16));
 
 	// @Note: This will be used for the STB allocations
-	Memory::EstablishTempScope(Megabytes(128));
+	Memory::EstablishTempScope();
 	Defer {
 		Memory::EndTempScope();
 		Memory::DestoryTempArena(fileArena);
@@ -51,7 +51,7 @@ TextureId TextureCatalog::LoadCube(Graphics& graphics, const char* name[6])
 	MemoryArena fileArena = Memory::GetTempArena(Megabytes(16));
 
 	// @Note: This will be used for the STB allocations
-	Memory::EstablishTempScope(Megabytes(128));
+	Memory::EstablishTempScope();
 	Defer { Memory::ResetTempMemory(); };
 
 	int width, height, channels;
@@ -84,7 +84,7 @@ void TextureCatalog::LoadTextures(Graphics* graphics, const char** paths, uint32
 	MemoryArena fileArena = Memory::GetTempArena(Megabytes(16));
 
 	// @Note: This will be used for the STB allocations
-	Memory::EstablishTempScope(Megabytes(128));
+	Memory::EstablishTempScope();
 	Defer {
 		Memory::EndTempScope();
 		Memory::DestoryTempArena(fileArena);
@@ -107,8 +107,8 @@ void TextureCatalog::LoadTextures(Graphics* graphics, const char** paths, uint32
 
 		LoadedTexture newTex;
 		newTex.Handle = NextTextureId();
-		newTex.Path = paths[i];
-		newTex.Name = paths[i];
+		newTex.Path = Strings::Intern(paths[i]);
+		newTex.Name = newTex.Path;
 
 			
 		graphics->CreateTexture(newTex.Handle, {(uint16)width, (uint16)height, TF_RGBA}, data);
@@ -126,7 +126,7 @@ void TextureCatalog::LoadCubes(Graphics* graphics, const char** paths, uint32 co
 		MemoryArena fileArena = Memory::GetTempArena(Megabytes(16));
 
 		// @Note: This will be used for the STB allocations
-		Memory::EstablishTempScope(Megabytes(128));
+		Memory::EstablishTempScope();
 		Defer { Memory::ResetTempMemory(); };
 
 		TempFormater formater;
@@ -160,8 +160,8 @@ void TextureCatalog::LoadCubes(Graphics* graphics, const char** paths, uint32 co
 
 			LoadedTexture newTex;
 			newTex.Handle = NextTextureId();
-			newTex.Path = paths[i];
-			newTex.Name = paths[i];
+			newTex.Path = Strings::Intern(paths[i]);
+			newTex.Name = newTex.Path;
 
 			graphics->CreateCubeTexture(newTex.Handle, {(uint16)width, (uint16)height, TF_RGBA}, data);
 			LoadedCubes.push_back(newTex);
@@ -6,6 +6,7 @@
 #include <Platform.hpp>
 #include <Resources.hpp>
 #include <FileUtils.hpp>
+#include <StringInterning.hpp>
 
 #include <stb_image.h>
 #include <fmt/format.h>
@@ -25,8 +26,8 @@ struct TextureLoadEntry_
 
 struct LoadedTexture
 {
-	String Path;
-	String Name;
+	StringId Path;
+	StringId Name;
 	TextureId Handle;
 };
 
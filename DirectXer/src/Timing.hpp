@@ -10,6 +10,7 @@
 #include <Memory.hpp>
 #include <GraphicsCommon.hpp>
 #include <Containers.hpp>
+#include <FlatMap.hpp>
 
 #include <optick.h>
 
@@ -27,15 +28,45 @@ struct Telemetry
 		uint64 Time;
 	};
 
+	// @Note: Updated from any thread that allocates
 	struct MemoryState
 	{
-		uint64 CurrentMemory;
+		std::atomic<uint64> CurrentMemory;
 	};
 
 	static inline Map<uint64, CycleCountedEntry> CycleCounters{};
-	static inline Map<uint64, TimedBlockEntry> BlockTimers{};
+	static inline FlatMap<uint64, TimedBlockEntry> BlockTimers{};
 	static inline MemoryState MemoryStates[Tags_Count]{0};
 
+	// @Note: How much virtual memory the engine has reserved and how
+	// much of it is actually backed by physical pages
+	static inline uint64 ReservedMemory{0};
+	static inline std::atomic<uint64> CommittedMemory{0};
+
+	// @Note: Frame memory used during the last frame and the most any
+	// frame has used so far
+	static inline uint64 LastFrameMemory{0};
+	static inline uint64 PeakFrameMemory{0};
+
+	// @Note: The last task graph that ran; the critical path is its
+	// longest chain of dependent tasks -- that is what bounds the frame
+	// no matter how many threads run the rest of the tasks
+	struct TaskGraphStats
+	{
+		const char* CriticalPath[Config::MaxFrameTasks];
+		uint32 CriticalPathLength;
+		uint64 CriticalPathCycles;
+		uint64 WorkCycles;
+		uint64 GraphCycles;
+	};
+
+	static inline TaskGraphStats LastTaskGraph{};
+
+	// @Note: How old the game state on the screen was when it got rendered;
+	// in frames and in cycles since its simulation started
+	static inline uint64 RenderLatencyFrames{0};
+	static inline uint64 RenderLatencyCycles{0};
+
 	static void NewCycleCounterEntry(SystemTag sysTag, CycleCounterTag counterTag, uint64 cycles)
 	{
 		auto& entry = CycleCounters[(uint64)sysTag << 32 | (uint64)counterTag];
@@ -52,12 +83,39 @@ struct Telemetry
 
 	static void AddMemory(SystemTag sysTag, uint64 memory)
 	{
-		MemoryStates[sysTag].CurrentMemory += memory;
+		MemoryStates[sysTag].CurrentMemory.fetch_add(memory, std::memory_order_relaxed);
 	}
 
 	static void RemoveMemory(SystemTag sysTag, uint64 memory)
 	{
-		MemoryStates[sysTag].CurrentMemory -= memory;
+		MemoryStates[sysTag].CurrentMemory.fetch_sub(memory, std::memory_order_relaxed);
+	}
+
+	static void AddReservedMemory(uint64 memory)
+	{
+		ReservedMemory += memory;
+	}
+
+	static void AddCommittedMemory(uint64 memory)
+	{
+		CommittedMemory += memory;
+	}
+
+	static void RecordFrameMemory(uint64 memory)
+	{
+		LastFrameMemory = memory;
+		PeakFrameMemory = memory > PeakFrameMemory ? memory : PeakFrameMemory;
+	}
+
+	static void RecordTaskGraph(const TaskGraphStats& t_Stats)
+	{
+		LastTaskGraph = t_Stats;
+	}
+
+	static void RecordRenderLatency(uint64 t_Frames, uint64 t_Cycles)
+	{
+		RenderLatencyFrames = t_Frames;
+		RenderLatencyCycles = t_Cycles;
 	}
 
 	static void Init()
@@ -81,6 +81,25 @@ inline uint32 jenkins_hash(const char* begin)
     return hash;
 }
 
+inline uint32 jenkins_hash(const char* begin, size_t length)
+{
+
+    uint32 hash = 0;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash += begin[i];
+        hash += hash << 10;
+        hash ^= hash >> 6;
+    }
+
+    hash += hash << 3;
+    hash ^= hash >> 11;
+    hash += hash << 15;
+
+    return hash;
+}
+
 #ifdef _DEBUG
 #define DxDebugCode(STATEMENT) STATEMENT
 #else
@@ -177,6 +177,116 @@ static void GenerateHeaderDefines(std::ofstream& headerFile, AssetBundlerContext
 	headerFile << "\n\n";
 }
 
+// @Note: Hash and displace; the names are split into buckets and the buckets
+// are placed from the biggest to the smallest, each one with the first seed
+// that sends all of its names to free slots. With ~4 names per bucket the search
+// finishes almost immediately; the bucket count is increased in the unlikely
+// case that some bucket cannot be placed at all.
+static std::vector<uint32> BuildNameHash(const std::vector<AssetDefine*>& names, std::vector<AssetDefine*>& slots)
+{
+	const size_t count = names.size();
+	static const uint32 MaxSeed = 1u << 20;
+
+	for (size_t bucketsCount = (count + 3) / 4;; bucketsCount = bucketsCount * 2)
+	{
+		std::vector<std::vector<AssetDefine*>> buckets(bucketsCount);
+		for (auto name : names) buckets[AssetNameHash(name->Name, 0) % bucketsCount].push_back(name);
+
+		std::vector<size_t> order(bucketsCount);
+		for (size_t i = 0; i < bucketsCount; ++i) order[i] = i;
+		std::stable_sort(order.begin(), order.end(), [&buckets](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+		std::vector<uint32> seeds(bucketsCount, 0);
+		slots.assign(count, nullptr);
+
+		bool placed = true;
+		std::vector<uint32> taken;
+		for (auto bucket : order)
+		{
+			if (buckets[bucket].empty()) break;
+
+			uint32 seed = 1;
+			for (; seed < MaxSeed; ++seed)
+			{
+				taken.clear();
+				for (auto name : buckets[bucket])
+				{
+					uint32 slot = AssetNameHash(name->Name, seed) % count;
+					if (slots[slot] || std::find(taken.begin(), taken.end(), slot) != taken.end()) break;
+					taken.push_back(slot);
+				}
+				if (taken.size() == buckets[bucket].size()) break;
+			}
+
+			if (seed == MaxSeed)
+			{
+				placed = false;
+				break;
+			}
+
+			seeds[bucket] = seed;
+			for (size_t i = 0; i < taken.size(); ++i) slots[taken[i]] = buckets[bucket][i];
+		}
+
+		if (placed) return seeds;
+	}
+}
+
+static void UpdateNameHash(AssetBundlerContext& context)
+{
+	if (context.NameHashDefines == context.Defines.size()) return;
+	context.NameHashDefines = context.Defines.size();
+	context.NameSeeds.clear();
+	context.NameSlots.clear();
+
+	// @Note: Only the first define of a name can be found through the name
+	std::vector<AssetDefine*> names;
+	for (auto& [name, index] : context.DefinesIndex) names.push_back(&context.Defines[index]);
+	if (names.empty()) return;
+	std::sort(names.begin(), names.end(), [](auto d1, auto d2) { return d1->Name < d2->Name; });
+
+	std::vector<AssetDefine*> slots;
+	context.NameSeeds = BuildNameHash(names, slots);
+	for (auto define : slots) context.NameSlots.push_back({ define->Name.c_str(), define->Id, (uint16)define->Type });
+}
+
+int32 AssetSlot(AssetBundlerContext& context, std::string_view name)
+{
+	UpdateNameHash(context);
+	return FindAssetSlot(context.NameSeeds.data(), context.NameSeeds.size(), context.NameSlots.data(), context.NameSlots.size(), name);
+}
+
+uint32 AssetIdOf(AssetBundlerContext& context, std::string_view name)
+{
+	int32 slot = AssetSlot(context, name);
+	return slot < 0 ? 0 : context.NameSlots[slot].Id;
+}
+
+static void GenerateHeaderNameHash(std::ofstream& headerFile, AssetBundlerContext& context)
+{
+	UpdateNameHash(context);
+	if (context.NameSlots.empty()) return;
+
+	const auto& seeds = context.NameSeeds;
+	headerFile << "static inline constexpr uint32 AssetNameSeeds[] = {\n";
+	for (size_t i = 0; i < seeds.size(); ++i)
+	{
+		headerFile << fmt::format("{}{},", i % 8 == 0 ? "\t" : " ", seeds[i]);
+		if (i % 8 == 7 || i == seeds.size() - 1) headerFile << "\n";
+	}
+	headerFile << "};\n\n";
+
+	headerFile << "static inline constexpr AssetName AssetNames[] = {\n";
+	for (const auto& name : context.NameSlots)
+		headerFile << fmt::format("\t{{ \"{}\", {}, {} }},\n", name.Name, name.Id, name.Type);
+	headerFile << "};\n\n";
+
+	headerFile << "// @Note: Dense slot of the asset in AssetNames or -1 if there is no such asset\n";
+	headerFile << "constexpr int32 AssetSlot(std::string_view t_Name) { return FindAssetSlot(AssetNameSeeds, AssetNames, t_Name); }\n";
+	headerFile << "constexpr uint32 AssetIdOf(std::string_view t_Name) { int32 slot = AssetSlot(t_Name); return slot < 0 ? 0 : AssetNames[slot].Id; }\n";
+	headerFile << "\n/* ------------------------------  */\n\n";
+}
+
 int main(int argc, char *argv[])
 {
 	AssetBuilder::CommandLineArguments arguments{};
@@ -402,6 +512,9 @@ int main(int argc, char *argv[])
 	GenerateHeaderArrays(headerFile, context, Type_Font, "Fonts");
 	GenerateHeaderArrays(headerFile, context, Type_Mesh, "Meshes");
 
+	// @Note: Generate the perfect hash from the asset names to their ids
+	GenerateHeaderNameHash(headerFile, context);
+
 	headerFile << "GPUResource GPUResources[] = {\n";
 	for(auto& define : context.Defines)
 	{
@@ -85,6 +85,17 @@ struct AssetBundlerContext
 {
 	AssetColletionHeader Header;
 	std::vector<AssetDefine> Defines;
+
+	// @Note: Index of each name in Defines so that the loaders can resolve
+	// names (usemtl and co.) without scanning all of the defines
+	std::unordered_map<std::string, size_t> DefinesIndex;
+
+	// @Note: The perfect hash of the generated header over the names
+	// defined so far; AssetSlot\AssetIdOf build it again once new names
+	// were added
+	std::vector<uint32> NameSeeds;
+	std::vector<AssetName> NameSlots;
+	size_t NameHashDefines{0};
 	
 	// @Note: Those objects will be created through the Graphics
 	std::vector<TextureLoadEntry> TexturesToCreate;
@@ -163,10 +174,20 @@ inline uint32 NewAssetName(AssetBundlerContext& context, AssetType type, const c
 {
 	static uint32 next = 0;
 	uint32 nextId = (id == 0 ?  ++next : id);
+	context.DefinesIndex.emplace(name, context.Defines.size());
 	context.Defines.push_back({ name, nextId, type });
 	return nextId;
 }
 
+inline AssetDefine* FindDefine(AssetBundlerContext& context, const std::string& name)
+{
+	auto it = context.DefinesIndex.find(name);
+	return it != context.DefinesIndex.end() ? &context.Defines[it->second] : nullptr;
+}
+
+int32 AssetSlot(AssetBundlerContext& context, std::string_view name);
+uint32 AssetIdOf(AssetBundlerContext& context, std::string_view name);
+
 inline TextureId NextTextureAssetId()
 {
 	static TextureId next = 0;
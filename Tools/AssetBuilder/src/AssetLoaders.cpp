@@ -271,8 +271,7 @@ static void LoadMtlMaterial(AssetToLoad asset, AssetBundlerContext& context, Ass
 			newMatName = ReplaceAll(newMatName, "\r", "");
 
 			// @Note: We don't want to load the same material twice
-			auto id = std::find_if(context.Defines.begin(), context.Defines.end(), [&newMatName](auto def) { return def.Name == newMatName; });
-			if( id != context.Defines.end())
+			if (FindDefine(context, newMatName))
 			{
 				newMatName.clear();
 			}
@@ -455,8 +454,7 @@ static void LoadPhongMaterial(AssetToLoad asset, AssetBundlerContext& context, A
 			newMatName = ReplaceAll(newMatName, "\r", "");
 
 			// @Note: We don't want to load the same material twice
-			auto id = std::find_if(context.Defines.begin(), context.Defines.end(), [&newMatName](auto def) { return def.Name == newMatName; });
-			if( id != context.Defines.end())
+			if (FindDefine(context, newMatName))
 			{
 				newMatName.clear();
 			}
@@ -548,8 +546,7 @@ static void LoadTexMaterial(AssetToLoad asset, AssetBundlerContext& context, Ass
 			newMatName = ReplaceAll(newMatName, "\r", "");
 				
 			// @Note: We don't want to load the same material twice
-			auto id = std::find_if(context.Defines.begin(), context.Defines.end(), [&newMatName](auto def) { return def.Name == newMatName; });
-			if( id != context.Defines.end())
+			if (FindDefine(context, newMatName))
 			{
 				newMatName.clear();
 			}
@@ -763,9 +760,9 @@ void LoadMesh(AssetToLoad asset, AssetBundlerContext& context, AssetDataBlob& bl
 		{
 			auto parts = SplitLine(line, ' ');
 			auto matName = ReplaceAll(parts[1], ".", "_");
-			auto id = std::find_if(context.Defines.begin(), context.Defines.end(), [&matName](auto def) { return def.Name == matName; });
-			assert(id != context.Defines.end());
-			mesh.Mesh.Material = id->Id;
+			const uint32 material = AssetIdOf(context, matName);
+			assert(material != 0);
+			mesh.Mesh.Material = material;
 		}
     }
 
@@ -791,9 +788,9 @@ void LoadMesh(AssetToLoad asset, AssetBundlerContext& context, AssetDataBlob& bl
 	// @Note: If the obj file does not define a material, we have to load and use a default one
 	if (mesh.Mesh.Material == 0)
 	{
-		auto define = std::find_if(context.Defines.begin(), context.Defines.end(), [](auto def) { return def.Name == "DefaultMaterial"; });
+		auto define = FindDefine(context, "DefaultMaterial");
 
-		if (define != context.Defines.end()) mesh.Mesh.Material = define->Id;
+		if (define) mesh.Mesh.Material = define->Id;
 		else mesh.Mesh.Material = LoadDefaultMaterial(context);
 	}
 	
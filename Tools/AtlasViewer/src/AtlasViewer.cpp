@@ -114,7 +114,7 @@ static void Init(Context& context)
 {
 	auto Graphics = &context.Graphics;
 
-	Memory::EstablishTempScope(Megabytes(16));
+	Memory::EstablishTempScope();
 	Defer {
 		Memory::EndTempScope();
 	};
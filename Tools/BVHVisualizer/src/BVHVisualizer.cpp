@@ -27,7 +27,7 @@ void Init(Context& context)
 	auto Graphics = &context.Graphics;
 	context.Renderer3D.InitRenderer(Graphics);
 
-	Memory::EstablishTempScope(Megabytes(4));
+	Memory::EstablishTempScope();
 	{
 		DebugGeometryBuilder builder;
 		builder.Init(8);
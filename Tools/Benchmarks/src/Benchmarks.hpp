@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Types.hpp>
+#include <Tags.hpp>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/*
+  @Note: Benchmarks and stress runs of the engine containers, allocators
+  and the job system. Every benchmark is a plain function that sets up
+  what it needs, prints its numbers and checks its results. The engine
+  asserts are compiled out of the release builds so the benchmarks check
+  with BenchCheck which fails the run in every build.
+*/
+
+#define BenchCheck(VALUE, MSG, ...) do { if (!(VALUE)) { fmt::print(stderr, "[Check failed] {}:{}: ", __FILE__, __LINE__); fmt::print(stderr, MSG, ##__VA_ARGS__); fmt::print(stderr, "\n"); std::exit(1); } } while(false)
+
+struct BenchTimer
+{
+	std::chrono::steady_clock::time_point Start{std::chrono::steady_clock::now()};
+
+	double Milliseconds() const
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+	}
+
+	double Nanoseconds() const
+	{
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - Start).count();
+	}
+};
+
+// @Note: Gets a memory budget from main so that its bulk allocations
+// always go through the shared counter of the budget
+static const SystemTag BenchmarkBulkTag = Memory_Audio;
+
+// @Note: Keeps the compiler from throwing away the work of a benchmark
+template<class T>
+inline void DoNotOptimize(const T& t_Value)
+{
+	asm volatile("" : : "r,m"(t_Value) : "memory");
+}
+
+void TempMemoryBenchmark();
+void HeapBenchmark();
+void SoABenchmark();
+void QueuesBenchmark();
+void RadixBenchmark();
+void JobsBenchmark();
+void ParallelBenchmark();
+void PipelineBenchmark();
+void BulkBenchmark();
+void FlatMapBenchmark();
+void SmallVectorBenchmark();
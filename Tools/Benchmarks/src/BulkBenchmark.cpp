@@ -0,0 +1,70 @@
+#include "Benchmarks.hpp"
+
+#include <Memory.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/*
+  @Note: Contention on the bulk memory from 1 to 64 threads. The small
+  allocations of the untagged bulk memory come from the chunk of their
+  thread; the allocations of a tag with a budget always bump the shared
+  counter of the budget, so BenchmarkBulkTag (given a budget by main)
+  gives the shared path with the same sizes. Every block gets the number
+  of its thread and its index written into it and all of them are
+  checked once the threads are done, so two threads getting the same
+  memory shows up.
+*/
+
+static const uint32 MaxBulkThreads = 64;
+static const uint32 AllocsPerThread = 16384;
+static const size_t AllocSize = 64;
+
+static void HammerBulk(uint32 t_Thread, SystemTag t_Tag, uint64** t_Blocks)
+{
+	for (uint32 i = 0; i < AllocsPerThread; ++i)
+	{
+		auto* block = (uint64*)Memory::BulkGet(AllocSize, t_Tag);
+		*block = uint64(t_Thread) << 32 | i;
+		t_Blocks[i] = block;
+	}
+}
+
+static double RunThreads(uint32 t_Threads, SystemTag t_Tag, const char* t_Name)
+{
+	std::vector<uint64*> blocks(size_t(t_Threads) * AllocsPerThread);
+	std::thread workers[MaxBulkThreads];
+
+	const BulkMarker marker = Memory::MarkBulk();
+	BenchTimer timer;
+	for (uint32 i = 0; i < t_Threads; ++i) workers[i] = std::thread(HammerBulk, i, t_Tag, &blocks[size_t(i) * AllocsPerThread]);
+	for (uint32 i = 0; i < t_Threads; ++i) workers[i].join();
+	const double ms = timer.Milliseconds();
+
+	for (uint32 thread = 0; thread < t_Threads; ++thread)
+	{
+		for (uint32 i = 0; i < AllocsPerThread; ++i)
+		{
+			const uint64* block = blocks[size_t(thread) * AllocsPerThread + i];
+			BenchCheck(((uintptr_t)block & (DefaultAlignment - 1)) == 0, "The {} path gave out an unaligned block with {} threads", t_Name, t_Threads);
+			BenchCheck(*block == (uint64(thread) << 32 | i), "The {} path gave the same memory to two threads with {} threads", t_Name, t_Threads);
+		}
+	}
+
+	Memory::RollbackBulk(marker);
+	return ms * 1e6 / (double(t_Threads) * AllocsPerThread);
+}
+
+void BulkBenchmark()
+{
+	fmt::print("{} allocations of {} bytes per thread, ns per allocation\n", AllocsPerThread, AllocSize);
+	fmt::print("{:>8} {:>12} {:>12}\n", "threads", "chunk", "shared");
+
+	for (uint32 threads = 1; threads <= MaxBulkThreads; threads *= 2)
+	{
+		const double chunk = RunThreads(threads, Tag_Unknown, "chunk");
+		const double shared = RunThreads(threads, BenchmarkBulkTag, "shared");
+		fmt::print("{:>8} {:>12.1f} {:>12.1f}\n", threads, chunk, shared);
+	}
+}
@@ -0,0 +1,94 @@
+#include "Benchmarks.hpp"
+
+#include <FlatMap.hpp>
+#include <Containers.hpp>
+#include <Timing.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/*
+  @Note: FlatMap against Map (robin_hood over the RobinAllocator) from 1k
+  to 1M entries of uint64 to uint64. Both maps start empty and grow while
+  the keys are inserted; the bytes are what the heap counts for their tag
+  once all of the keys are in, so the blocks that the growing left behind
+  show up as well. The lookups go over the inserted keys in a shuffled
+  order and over keys that were never inserted.
+*/
+
+static const SystemTag MapsTag = Memory_Strings;
+
+struct MapResult
+{
+	double Insert;
+	double Hit;
+	double Miss;
+	uint64 Bytes;
+};
+
+template<class MapType>
+static MapResult RunMap(const std::vector<uint64>& t_Keys, const std::vector<uint64>& t_Lookups, const std::vector<uint64>& t_Misses, const char* t_Name)
+{
+	MapResult result;
+	const uint64 memoryBefore = Telemetry::MemoryStates[MapsTag].CurrentMemory.load();
+	{
+		MapType map;
+
+		BenchTimer insertTimer;
+		for (uint64 key : t_Keys) map.insert({ key, ~key });
+		result.Insert = insertTimer.Nanoseconds() / t_Keys.size();
+		result.Bytes = Telemetry::MemoryStates[MapsTag].CurrentMemory.load() - memoryBefore;
+		BenchCheck(map.size() == t_Keys.size(), "{} holds {} entries instead of {}", t_Name, map.size(), t_Keys.size());
+
+		uint64 sum = 0;
+		BenchTimer hitTimer;
+		for (uint64 key : t_Lookups) sum += map.find(key)->second;
+		result.Hit = hitTimer.Nanoseconds() / t_Lookups.size();
+
+		uint64 expected = 0;
+		for (uint64 key : t_Lookups) expected += ~key;
+		BenchCheck(sum == expected, "{} found the wrong values", t_Name);
+
+		size_t found = 0;
+		BenchTimer missTimer;
+		for (uint64 key : t_Misses) found += map.find(key) != map.end() ? 1 : 0;
+		result.Miss = missTimer.Nanoseconds() / t_Misses.size();
+		BenchCheck(found == 0, "{} found {} keys that were never inserted", t_Name, found);
+	}
+	BenchCheck(Telemetry::MemoryStates[MapsTag].CurrentMemory.load() == memoryBefore, "{} did not give all of its memory back", t_Name);
+
+	return result;
+}
+
+void FlatMapBenchmark()
+{
+	fmt::print("uint64 to uint64, ns per operation and heap bytes after the inserts\n");
+	fmt::print("{:>8} {:>8} {:>10} {:>10} {:>10} {:>12}\n", "entries", "map", "insert", "hit", "miss", "bytes");
+
+	std::mt19937_64 random{7};
+	for (size_t count = 1000; count <= 1000000; count *= 10)
+	{
+		// @Note: The odd keys are inserted and the even ones are the misses
+		std::vector<uint64> keys(count);
+		std::vector<uint64> misses(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint64 key = random();
+			keys[i] = key | 1;
+			misses[i] = key & ~uint64(1);
+		}
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+		std::shuffle(keys.begin(), keys.end(), random);
+
+		std::vector<uint64> lookups = keys;
+		std::shuffle(lookups.begin(), lookups.end(), random);
+
+		const MapResult flat = RunMap<FlatMap<uint64, uint64, MapsTag>>(keys, lookups, misses, "FlatMap");
+		const MapResult robin = RunMap<Map<uint64, uint64, MapsTag>>(keys, lookups, misses, "Map");
+
+		fmt::print("{:>8} {:>8} {:>10.1f} {:>10.1f} {:>10.1f} {:>12}\n", keys.size(), "FlatMap", flat.Insert, flat.Hit, flat.Miss, flat.Bytes);
+		fmt::print("{:>8} {:>8} {:>10.1f} {:>10.1f} {:>10.1f} {:>12}\n", keys.size(), "Map", robin.Insert, robin.Hit, robin.Miss, robin.Bytes);
+	}
+}
@@ -0,0 +1,147 @@
+#include "Benchmarks.hpp"
+
+#include <Memory.hpp>
+#include <MemoryHeap.hpp>
+
+#include <atomic>
+#include <thread>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+
+// @Note: A heap without any pools; the first allocation has to add one
+static TLSFHeap* NewColdHeap()
+{
+	auto* heap = new (Memory::BulkGet(sizeof(TLSFHeap), Tag_Unknown, alignof(TLSFHeap))) TLSFHeap{0};
+	heap->Owner = Tag_Unknown;
+	return heap;
+}
+
+// @Note: Allocations bigger than the default pool get a pool of their own;
+// the pool has to be found by the search that follows it
+static void CheckColdAllocations()
+{
+	const size_t sizes[] = { Megabytes(5), Megabytes(5) + 16, Megabytes(64), Megabytes(64) + 1 };
+	const size_t aligns[] = { TLSFHeap::Align, 256 };
+
+	for (size_t size : sizes)
+	{
+		for (size_t align : aligns)
+		{
+			TLSFHeap* heap = NewColdHeap();
+			char* memory = (char*)heap->Alloc(size, Memory_GameState, align);
+			BenchCheck(memory, "A cold heap can't allocate {} bytes", size);
+			BenchCheck(((uintptr_t)memory & (align - 1)) == 0, "The allocation of {} bytes is not aligned to {}", size, align);
+			BenchCheck(heap->BlockSize(memory) >= size, "The block of {} bytes is too small", size);
+
+			memset(memory, 0xAB, size);
+			heap->Free(memory);
+			BenchCheck(heap->LargestFreeBlock() >= size, "Freeing {} bytes did not give the block back", size);
+
+			fmt::print("cold {:>10} bytes aligned to {:>3}: ok ({} pools)\n", size, align, heap->PoolsCount);
+		}
+	}
+}
+
+static const uint32 HeapOperations = 200000;
+
+// @Note: Random sizes up to 2KB with up to 64 live blocks per thread;
+// every block is filled with the number of its thread and checked before
+// it is freed
+static void HammerHeap(uint8 t_Thread, std::atomic<uint32>& t_Errors)
+{
+	std::mt19937 random(t_Thread);
+	struct Live { uint8* Memory; size_t Size; } live[64];
+	uint32 liveCount = 0;
+
+	for (uint32 i = 0; i < HeapOperations; ++i)
+	{
+		if (liveCount < 64 && (liveCount == 0 || random() % 2))
+		{
+			const size_t size = 16 + random() % 2000;
+			auto* memory = (uint8*)Memory::HeapAlloc(size, Memory_GameState);
+			memset(memory, t_Thread, size);
+			live[liveCount++] = { memory, size };
+			continue;
+		}
+
+		const uint32 index = random() % liveCount;
+		for (size_t j = 0; j < live[index].Size; j += 61)
+		{
+			if (live[index].Memory[j] != t_Thread) t_Errors.fetch_add(1);
+		}
+		Memory::HeapFree(live[index].Memory);
+		live[index] = live[--liveCount];
+	}
+
+	for (uint32 i = 0; i < liveCount; ++i) Memory::HeapFree(live[i].Memory);
+}
+
+static const uint32 AllocOperations = 1000000;
+static const uint32 BulkRollbackEvery = 1024;
+
+static size_t AllocSize(uint32 t_Index)
+{
+	return 64 + (t_Index & 255);
+}
+
+// @Note: The same loop of an allocation and its free on the TLSF heap, the
+// bulk bump allocator and malloc. The bump allocator can't free a single
+// block so it gives its memory back by rolling back to a marker every few
+// allocations, which is how the levels use it
+static void CompareAllocators()
+{
+	BenchTimer heapTimer;
+	for (uint32 i = 0; i < AllocOperations; ++i)
+	{
+		void* memory = Memory::HeapAlloc(AllocSize(i));
+		DoNotOptimize(memory);
+		Memory::HeapFree(memory);
+	}
+	const double heap = heapTimer.Nanoseconds() / AllocOperations;
+
+	BenchTimer bulkTimer;
+	BulkMarker marker = Memory::MarkBulk();
+	for (uint32 i = 0; i < AllocOperations; ++i)
+	{
+		void* memory = Memory::BulkGet(AllocSize(i));
+		DoNotOptimize(memory);
+		if ((i + 1) % BulkRollbackEvery == 0) Memory::RollbackBulk(marker);
+	}
+	Memory::RollbackBulk(marker);
+	const double bulk = bulkTimer.Nanoseconds() / AllocOperations;
+
+	BenchTimer mallocTimer;
+	for (uint32 i = 0; i < AllocOperations; ++i)
+	{
+		void* memory = std::malloc(AllocSize(i));
+		DoNotOptimize(memory);
+		std::free(memory);
+	}
+	const double libc = mallocTimer.Nanoseconds() / AllocOperations;
+
+	fmt::print("alloc + free of 64 to 319 bytes in ns\n");
+	fmt::print("{:>12} {:>12} {:>12}\n", "TLSF", "bulk", "malloc");
+	fmt::print("{:>12.1f} {:>12.1f} {:>12.1f}\n\n", heap, bulk, libc);
+}
+
+void HeapBenchmark()
+{
+	CheckColdAllocations();
+	CompareAllocators();
+
+	fmt::print("{:>8} {:>12} {:>12}\n", "threads", "ms", "ns/op");
+	for (uint8 threads = 1; threads <= 8; threads *= 2)
+	{
+		std::atomic<uint32> errors{0};
+		std::thread workers[8];
+
+		BenchTimer threadsTimer;
+		for (uint8 i = 0; i < threads; ++i) workers[i] = std::thread(HammerHeap, uint8(i + 1), std::ref(errors));
+		for (uint8 i = 0; i < threads; ++i) workers[i].join();
+		const double ms = threadsTimer.Milliseconds();
+
+		fmt::print("{:>8} {:>12.2f} {:>12.1f}\n", threads, ms, ms * 1e6 / (double(threads) * HeapOperations));
+		BenchCheck(errors.load() == 0, "{} threads corrupted each other's heap blocks {} times", threads, errors.load());
+	}
+}
@@ -0,0 +1,85 @@
+#include "Benchmarks.hpp"
+
+#include <Jobs.hpp>
+#include <Parallel.hpp>
+#include <Memory.hpp>
+
+#include <atomic>
+#include <cmath>
+
+/*
+  @Note: Scaling of the job system on a synthetic workload of 1M items with
+  1, 2, 4 and 8 threads; the job system is started anew for every thread
+  count. Every run also starts more jobs at once than the ring of a worker
+  holds to check that the jobs over the limit still run exactly once.
+*/
+
+static const size_t ItemsCount = 1000000;
+static const size_t Grain = 4096;
+static const uint32 Iterations = 10;
+static const uint32 BurstJobs = 3 * JobSystem::JobsPerWorker;
+
+static float Work(size_t t_Index)
+{
+	float value = float(t_Index);
+	for (uint32 i = 0; i < 16; ++i) value = std::sqrt(value * 1.0001f + float(i));
+	return value;
+}
+
+static void RunWorkload(float* t_Out)
+{
+	ParallelFor(ItemsCount, Grain, [t_Out](size_t t_Begin, size_t t_End) {
+		for (size_t i = t_Begin; i < t_End; ++i) t_Out[i] = Work(i);
+	});
+}
+
+static void RunBurst(std::atomic<uint32>* t_Ran)
+{
+	JobCounter counter;
+	for (uint32 i = 0; i < BurstJobs; ++i)
+	{
+		JobSystem::Run(counter, [t_Ran]() { t_Ran->fetch_add(1, std::memory_order_relaxed); });
+	}
+	JobSystem::Wait(counter);
+}
+
+void JobsBenchmark()
+{
+	Memory::EstablishTempScope();
+	float* expected = (float*)Memory::TempAlloc(ItemsCount * sizeof(float), CacheLineSize);
+	float* out = (float*)Memory::TempAlloc(ItemsCount * sizeof(float), CacheLineSize);
+
+	BenchTimer serialTimer;
+	for (size_t i = 0; i < ItemsCount; ++i) expected[i] = Work(i);
+	const double serial = serialTimer.Milliseconds();
+
+	fmt::print("{} items in chunks of {}, serial loop {:.2f}ms\n", ItemsCount, Grain, serial);
+	fmt::print("{:>8} {:>12} {:>10}\n", "threads", "ms", "speedup");
+
+	for (uint32 workers = 0; workers <= JobSystem::MaxWorkers; workers = workers * 2 + 1)
+	{
+		const BulkMarker marker = Memory::MarkBulk();
+		JobSystem::Init(workers);
+
+		RunWorkload(out);
+		BenchTimer timer;
+		for (uint32 i = 0; i < Iterations; ++i) RunWorkload(out);
+		const double ms = timer.Milliseconds() / Iterations;
+
+		for (size_t i = 0; i < ItemsCount; ++i)
+		{
+			BenchCheck(out[i] == expected[i], "The parallel loop with {} workers got {} at {} instead of {}", workers, out[i], i, expected[i]);
+		}
+
+		std::atomic<uint32> ran{0};
+		RunBurst(&ran);
+		BenchCheck(ran.load() == BurstJobs, "{} of {} jobs ran with {} workers when starting more jobs than fit in the ring", ran.load(), BurstJobs, workers);
+
+		fmt::print("{:>8} {:>12.2f} {:>10.2f}\n", JobSystem::ThreadsCount(), ms, serial / ms);
+
+		JobSystem::Shutdown();
+		Memory::RollbackBulk(marker);
+	}
+
+	Memory::EndTempScope();
+}
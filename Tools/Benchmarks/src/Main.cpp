@@ -0,0 +1,57 @@
+#include "Benchmarks.hpp"
+
+#include <Memory.hpp>
+#include <Platform.hpp>
+
+#include <cstring>
+
+struct Benchmark
+{
+	const char* Name;
+	void (*Run)();
+};
+
+static const Benchmark Benchmarks[] = {
+	{ "temp-memory", TempMemoryBenchmark },
+	{ "heap", HeapBenchmark },
+	{ "bulk", BulkBenchmark },
+	{ "flatmap", FlatMapBenchmark },
+	{ "small-vector", SmallVectorBenchmark },
+	{ "soa", SoABenchmark },
+	{ "queues", QueuesBenchmark },
+	{ "radix", RadixBenchmark },
+	{ "jobs", JobsBenchmark },
+	{ "parallel", ParallelBenchmark },
+	{ "pipeline", PipelineBenchmark },
+};
+
+static bool Selected(const char* t_Name, char** argv, int argc)
+{
+	if (argc < 2) return true;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], t_Name) == 0) return true;
+	}
+	return false;
+}
+
+// @Note: "Benchmarks [name...]" runs the given benchmarks; all of them
+// without any names
+int main(int argc, char** argv)
+{
+	PlatformLayer::Init();
+	MemorySettings settings{};
+	settings.Budgets[BenchmarkBulkTag] = Megabytes(128);
+	Memory::InitMemoryState(settings);
+
+	for (const auto& benchmark : Benchmarks)
+	{
+		if (!Selected(benchmark.Name, argv, argc)) continue;
+
+		fmt::print("== {}\n", benchmark.Name);
+		benchmark.Run();
+		fmt::print("\n");
+	}
+
+	return 0;
+}
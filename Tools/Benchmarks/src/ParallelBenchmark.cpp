@@ -0,0 +1,164 @@
+#include "Benchmarks.hpp"
+
+#include <Parallel.hpp>
+#include <Math.hpp>
+#include <Jobs.hpp>
+#include <Memory.hpp>
+
+#include <cstring>
+#include <vector>
+
+/*
+  @Note: The loops that went onto ParallelFor, serial against parallel:
+  TransformVertices over a big mesh and the instance matrices of the
+  ExampleScenes scaled up to many instances. PutPixels of the texture packer
+  is a static function of that tool so its old per-pixel copy and the new
+  per-row one are repeated here. The last loop has a grain of one to check
+  that a loop with many more chunks than jobs still covers every index
+  exactly once.
+*/
+
+static const uint32 ParallelWorkers = 3;
+static const uint32 Iterations = 10;
+static const size_t VerticesCount = 1000000;
+static const size_t InstancesCount = 65536;
+static const size_t ImageSize = 512;
+static const size_t AtlasSize = 2048;
+static const size_t ManyChunksCount = 1u << 20;
+
+struct InstanceMatrices
+{
+	glm::mat4 Model;
+	glm::mat4 InvModel;
+};
+
+static glm::mat4 InstanceModel(size_t t_Index)
+{
+	return init_scale(0.5f) * init_translate(-4.5f + 1.5f * (8 - (t_Index & 0x0F)), 0.0f, -5.0f + 1.5f * (8 - ((t_Index & 0xF0) >> 4) - 1));
+}
+
+static void SetupInstances(InstanceMatrices* t_Instances, size_t t_Begin, size_t t_End)
+{
+	for (size_t i = t_Begin; i < t_End; ++i)
+	{
+		t_Instances[i].Model = InstanceModel(i);
+		t_Instances[i].InvModel = glm::inverse(t_Instances[i].Model);
+	}
+}
+
+// @Note: The rect of stb_rect_pack that the texture packer gets
+struct PackedRect
+{
+	int x, y, w, h;
+};
+
+static void PutPixelsPerPixel(std::vector<unsigned char>& atlasBytes, PackedRect rect, unsigned char* data, size_t atlasSize)
+{
+	for (size_t i = 0; i < (size_t)rect.h; ++i)
+	{
+		for (size_t j = 0; j < (size_t)rect.w; ++j)
+		{
+			atlasBytes[((i + rect.y) * atlasSize + (j + rect.x))*4 + 0] = data[(i*rect.w + j)*4 + 0];
+			atlasBytes[((i + rect.y) * atlasSize + (j + rect.x))*4 + 1] = data[(i*rect.w + j)*4 + 1];
+			atlasBytes[((i + rect.y) * atlasSize + (j + rect.x))*4 + 2] = data[(i*rect.w + j)*4 + 2];
+			atlasBytes[((i + rect.y) * atlasSize + (j + rect.x))*4 + 3] = data[(i*rect.w + j)*4 + 3];
+		}
+	}
+}
+
+static void PutPixelsPerRow(std::vector<unsigned char>& atlasBytes, PackedRect rect, unsigned char* data, size_t atlasSize)
+{
+	const size_t rowSize = (size_t)rect.w * 4;
+	for (size_t i = 0; i < (size_t)rect.h; ++i)
+	{
+		std::memcpy(&atlasBytes[((i + rect.y) * atlasSize + rect.x) * 4], &data[i * rowSize], rowSize);
+	}
+}
+
+template<class Loop>
+static double TimeLoop(Loop t_Loop)
+{
+	t_Loop();
+	BenchTimer timer;
+	for (uint32 i = 0; i < Iterations; ++i) t_Loop();
+	return timer.Milliseconds() / Iterations;
+}
+
+static void PrintRow(const char* t_Name, double t_Serial, double t_Parallel)
+{
+	fmt::print("{:>20} {:>12.3f} {:>12.3f}\n", t_Name, t_Serial, t_Parallel);
+}
+
+void ParallelBenchmark()
+{
+	JobSystem::Init(ParallelWorkers);
+	Memory::EstablishTempScope();
+
+	fmt::print("{} threads, average of {} runs in ms\n", JobSystem::ThreadsCount(), Iterations);
+	fmt::print("{:>20} {:>12} {:>12}\n", "loop", "serial", "parallel");
+
+	{
+		auto* vertices = (ColorVertex*)Memory::TempAlloc(VerticesCount * sizeof(ColorVertex), CacheLineSize);
+		auto* expected = (ColorVertex*)Memory::TempAlloc(VerticesCount * sizeof(ColorVertex), CacheLineSize);
+		for (size_t i = 0; i < VerticesCount; ++i) vertices[i].pos = expected[i].pos = { float(i % 100), float(i % 37), float(i % 11) };
+
+		// @Note: A translation keeps the positions exact over all of the runs
+		const glm::mat4 transform = init_translate(1.0f, -1.0f, 0.5f);
+		const double serial = TimeLoop([&]() { for (size_t i = 0; i < VerticesCount; ++i) TransformVertex(expected[i], transform); });
+		const double parallel = TimeLoop([&]() { TransformVertices(transform, vertices, VerticesCount); });
+		PrintRow("TransformVertices", serial, parallel);
+
+		for (size_t i = 0; i < VerticesCount; ++i)
+		{
+			BenchCheck(vertices[i].pos == expected[i].pos, "TransformVertices differs from the serial loop at {}", i);
+		}
+	}
+
+	{
+		auto* instances = (InstanceMatrices*)Memory::TempAlloc(InstancesCount * sizeof(InstanceMatrices), CacheLineSize);
+		auto* expected = (InstanceMatrices*)Memory::TempAlloc(InstancesCount * sizeof(InstanceMatrices), CacheLineSize);
+		const double serial = TimeLoop([&]() { SetupInstances(expected, 0, InstancesCount); });
+		const double parallel = TimeLoop([&]() {
+			ParallelFor(InstancesCount, 8, [instances](size_t t_Begin, size_t t_End) { SetupInstances(instances, t_Begin, t_End); });
+		});
+		PrintRow("Instance matrices", serial, parallel);
+
+		BenchCheck(std::memcmp(instances, expected, InstancesCount * sizeof(InstanceMatrices)) == 0, "The parallel instance matrices differ from the serial ones");
+	}
+
+	{
+		auto* image = (unsigned char*)Memory::TempAlloc(ImageSize * ImageSize * 4);
+		for (size_t i = 0; i < ImageSize * ImageSize * 4; ++i) image[i] = (unsigned char)(i * 7);
+		std::vector<unsigned char> perPixel(AtlasSize * AtlasSize * 4, 0);
+		std::vector<unsigned char> perRow(AtlasSize * AtlasSize * 4, 0);
+		const PackedRect rect{ 300, 700, (int)ImageSize, (int)ImageSize };
+
+		const double pixel = TimeLoop([&]() { PutPixelsPerPixel(perPixel, rect, image, AtlasSize); });
+		const double row = TimeLoop([&]() { PutPixelsPerRow(perRow, rect, image, AtlasSize); });
+		fmt::print("{:>20} {:>12.3f} {:>12.3f} (per pixel, per row)\n", "PutPixels", pixel, row);
+
+		BenchCheck(perPixel == perRow, "The per row PutPixels differs from the per pixel one");
+	}
+
+	{
+		auto* visits = (uint32*)Memory::TempAlloc(ManyChunksCount * sizeof(uint32), CacheLineSize);
+		std::memset(visits, 0, ManyChunksCount * sizeof(uint32));
+		auto* serialVisits = (uint32*)Memory::TempAlloc(ManyChunksCount * sizeof(uint32), CacheLineSize);
+		std::memset(serialVisits, 0, ManyChunksCount * sizeof(uint32));
+		const double serial = TimeLoop([serialVisits]() { for (size_t i = 0; i < ManyChunksCount; ++i) ++serialVisits[i]; });
+		const double parallel = TimeLoop([visits]() {
+			ParallelFor(ManyChunksCount, 1, [visits](size_t t_Begin, size_t t_End) {
+				for (size_t i = t_Begin; i < t_End; ++i) ++visits[i];
+			});
+		});
+		PrintRow("Grain of one", serial, parallel);
+
+		for (size_t i = 0; i < ManyChunksCount; ++i)
+		{
+			BenchCheck(visits[i] == Iterations + 1, "Index {} of the grain one loop was visited {} times instead of {}", i, visits[i], Iterations + 1);
+		}
+	}
+
+	Memory::EndTempScope();
+	JobSystem::Shutdown();
+}
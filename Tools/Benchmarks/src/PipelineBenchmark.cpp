@@ -0,0 +1,162 @@
+#include "Benchmarks.hpp"
+
+#include <Jobs.hpp>
+
+#include <cmath>
+#include <vector>
+
+/*
+  @Note: The frame loop of the SpaceGame in both of its modes over a
+  synthetic game: the simulation moves a few thousand entities and writes
+  the snapshot of what is to be drawn, the rendering builds the quads of
+  a snapshot. Without the pipelining a frame simulates and then renders;
+  with it the next frame is simulated as a job while this thread renders
+  the snapshot of the frame before. Both modes must draw the same frames
+  and the pipelined one must draw every frame exactly one frame late.
+*/
+
+static const uint32 PipelineWorkers = 1;
+static const size_t EntitiesCount = 20000;
+static const uint32 FramesCount = 600;
+static const float DeltaTime = 1.0f / 60.0f;
+
+struct PipelineEntity
+{
+	float X;
+	float Y;
+	float XVelocity;
+	float YVelocity;
+};
+
+struct PipelineSnapshot
+{
+	std::vector<float> Positions;
+	uint32 Frame;
+};
+
+struct PipelineQuad
+{
+	float Vertices[8];
+};
+
+struct PipelineGame
+{
+	std::vector<PipelineEntity> Entities;
+	std::vector<PipelineQuad> Quads;
+	std::vector<double> Drawn;
+	uint32 SimulatedFrames;
+
+	void Init()
+	{
+		Entities.resize(EntitiesCount);
+		for (size_t i = 0; i < EntitiesCount; ++i)
+		{
+			Entities[i] = { float(i % 800), float(i % 600), float(i % 13) - 6.0f, float(i % 7) + 1.0f };
+		}
+		Quads.resize(EntitiesCount);
+		Drawn.assign(FramesCount + 1, 0.0);
+		SimulatedFrames = 0;
+	}
+
+	// @Note: Some math per entity so the simulation costs about as much as the rendering
+	void Simulate(PipelineSnapshot& t_Snapshot)
+	{
+		for (auto& entity : Entities)
+		{
+			entity.X += entity.XVelocity * DeltaTime;
+			entity.Y += entity.YVelocity * DeltaTime;
+			if (entity.X < 0.0f || entity.X > 800.0f) entity.XVelocity = -entity.XVelocity;
+			if (entity.Y > 600.0f) entity.Y -= 600.0f;
+			entity.XVelocity += std::sin(entity.Y * 0.01f) * 0.001f;
+		}
+
+		++SimulatedFrames;
+		t_Snapshot.Positions.resize(EntitiesCount * 2);
+		for (size_t i = 0; i < EntitiesCount; ++i)
+		{
+			t_Snapshot.Positions[i * 2 + 0] = Entities[i].X;
+			t_Snapshot.Positions[i * 2 + 1] = Entities[i].Y;
+		}
+		t_Snapshot.Frame = SimulatedFrames;
+	}
+
+	// @Note: Looks only at the snapshot and keeps a sum of every drawn frame to compare the modes
+	void Render(const PipelineSnapshot& t_Snapshot)
+	{
+		double sum = 0.0;
+		for (size_t i = 0; i < EntitiesCount; ++i)
+		{
+			const float x = t_Snapshot.Positions[i * 2 + 0];
+			const float y = t_Snapshot.Positions[i * 2 + 1];
+			const float size = 8.0f + std::sqrt(x * 0.01f + y * 0.01f);
+			Quads[i] = { { x, y, x + size, y, x + size, y + size, x, y + size } };
+			sum += x + y * 3.0f;
+		}
+		DoNotOptimize(Quads);
+		Drawn[t_Snapshot.Frame] = sum;
+	}
+};
+
+static double RunSerial(PipelineGame& t_Game)
+{
+	PipelineSnapshot snapshot{};
+	BenchTimer timer;
+	for (uint32 i = 0; i < FramesCount; ++i)
+	{
+		t_Game.Simulate(snapshot);
+		t_Game.Render(snapshot);
+		BenchCheck(snapshot.Frame == t_Game.SimulatedFrames, "The serial loop drew frame {} instead of {}", snapshot.Frame, t_Game.SimulatedFrames);
+	}
+	return timer.Milliseconds();
+}
+
+// @Note: The same flip of the two snapshots as in SpaceGame::Update
+static double RunPipelined(PipelineGame& t_Game)
+{
+	PipelineSnapshot snapshots[2]{};
+	uint8 rendered = 0;
+
+	BenchTimer timer;
+	t_Game.Simulate(snapshots[rendered]);
+	for (uint32 i = 1; i < FramesCount; ++i)
+	{
+		const uint8 simulated = rendered ^ 1;
+		PipelineSnapshot* snapshot = &snapshots[simulated];
+		PipelineGame* game = &t_Game;
+
+		JobCounter simulation;
+		JobSystem::Run(simulation, [game, snapshot]() { game->Simulate(*snapshot); });
+		t_Game.Render(snapshots[rendered]);
+		JobSystem::Wait(simulation);
+
+		BenchCheck(t_Game.SimulatedFrames - snapshots[rendered].Frame == 1, "The pipelined loop drew frame {} while simulating {}", snapshots[rendered].Frame, t_Game.SimulatedFrames);
+		rendered = simulated;
+	}
+	t_Game.Render(snapshots[rendered]);
+	return timer.Milliseconds();
+}
+
+void PipelineBenchmark()
+{
+	JobSystem::Init(PipelineWorkers);
+
+	PipelineGame serial;
+	serial.Init();
+	const double serialTime = RunSerial(serial);
+
+	PipelineGame pipelined;
+	pipelined.Init();
+	const double pipelinedTime = RunPipelined(pipelined);
+
+	for (uint32 i = 1; i <= FramesCount; ++i)
+	{
+		BenchCheck(serial.Drawn[i] == pipelined.Drawn[i], "Frame {} was drawn differently with the pipelining", i);
+	}
+
+	fmt::print("{} entities, {} frames, {} threads\n", EntitiesCount, FramesCount, JobSystem::ThreadsCount());
+	fmt::print("{:>10} {:>12} {:>12} {:>16}\n", "mode", "ms", "frames/s", "latency frames");
+	fmt::print("{:>10} {:>12.2f} {:>12.1f} {:>16}\n", "serial", serialTime, FramesCount * 1000.0 / serialTime, 0);
+	fmt::print("{:>10} {:>12.2f} {:>12.1f} {:>16}\n", "pipelined", pipelinedTime, FramesCount * 1000.0 / pipelinedTime, 1);
+
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,152 @@
+#include "Benchmarks.hpp"
+
+#include <Queues.hpp>
+
+#include <atomic>
+#include <thread>
+
+/*
+  @Note: Throughput of the queues with different numbers of producers and
+  consumers and the round trip latency of a ping-pong between two threads.
+  The items carry the index of their producer in the high bits so the
+  consumers can check that nothing is lost, duplicated or reordered. A side
+  that finds the queue full (or empty) yields and tries again.
+*/
+
+static const size_t QueueCapacity = 1024;
+static const uint64 ItemsCount = 1u << 20;
+static const uint32 RoundTrips = 20000;
+static const uint32 MaxSides = 4;
+
+struct ConsumerResult
+{
+	uint64 Count;
+	uint64 Sum;
+	uint64 LastSeen[MaxSides];
+	bool Ordered;
+};
+
+template<class Queue>
+static void Produce(Queue& t_Queue, uint64 t_Producer, uint64 t_Count)
+{
+	for (uint64 i = 1; i <= t_Count; ++i)
+	{
+		while (!t_Queue.Push(t_Producer << 32 | i)) std::this_thread::yield();
+	}
+}
+
+template<class Queue>
+static void Consume(Queue& t_Queue, std::atomic<uint64>& t_Remaining, ConsumerResult& t_Result)
+{
+	t_Result = {};
+	t_Result.Ordered = true;
+
+	uint64 item;
+	while (t_Remaining.load(std::memory_order_relaxed) > 0)
+	{
+		if (!t_Queue.Pop(item))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		t_Remaining.fetch_sub(1, std::memory_order_relaxed);
+
+		// @Note: One consumer sees the items of a producer in the order they were pushed
+		const uint64 producer = item >> 32;
+		const uint64 sequence = item & 0xFFFFFFFF;
+		if (sequence <= t_Result.LastSeen[producer]) t_Result.Ordered = false;
+		t_Result.LastSeen[producer] = sequence;
+
+		++t_Result.Count;
+		t_Result.Sum += sequence;
+	}
+}
+
+template<class Queue>
+static void Throughput(Queue& t_Queue, const char* t_Name, uint32 t_Producers, uint32 t_Consumers)
+{
+	const uint64 perProducer = ItemsCount / t_Producers;
+	std::atomic<uint64> remaining{perProducer * t_Producers};
+	ConsumerResult results[MaxSides];
+	std::thread producers[MaxSides];
+	std::thread consumers[MaxSides];
+
+	BenchTimer timer;
+	for (uint32 i = 0; i < t_Consumers; ++i) consumers[i] = std::thread([&, i]() { Consume(t_Queue, remaining, results[i]); });
+	for (uint32 i = 0; i < t_Producers; ++i) producers[i] = std::thread([&, i]() { Produce(t_Queue, i, perProducer); });
+	for (uint32 i = 0; i < t_Producers; ++i) producers[i].join();
+	for (uint32 i = 0; i < t_Consumers; ++i) consumers[i].join();
+	const double ms = timer.Milliseconds();
+
+	uint64 count = 0;
+	uint64 sum = 0;
+	for (uint32 i = 0; i < t_Consumers; ++i)
+	{
+		BenchCheck(results[i].Ordered, "{} consumer {} got the items of a producer out of order", t_Name, i);
+		count += results[i].Count;
+		sum += results[i].Sum;
+	}
+	BenchCheck(count == perProducer * t_Producers, "{} delivered {} items instead of {}", t_Name, count, perProducer * t_Producers);
+	BenchCheck(sum == t_Producers * (perProducer * (perProducer + 1) / 2), "{} lost or duplicated items", t_Name);
+
+	fmt::print("{:>6} {:>10} {:>10} {:>12.2f} {:>12.2f}\n", t_Name, t_Producers, t_Consumers, ms, count / (ms * 1000.0));
+}
+
+// @Note: The ping thread sends a value and waits for it to come back
+template<class Queue>
+static void Latency(Queue& t_There, Queue& t_Back, const char* t_Name)
+{
+	std::thread pong([&]() {
+		uint64 item;
+		for (uint32 i = 0; i < RoundTrips; ++i)
+		{
+			while (!t_There.Pop(item)) std::this_thread::yield();
+			while (!t_Back.Push(item)) std::this_thread::yield();
+		}
+	});
+
+	BenchTimer timer;
+	for (uint64 i = 0; i < RoundTrips; ++i)
+	{
+		uint64 item;
+		while (!t_There.Push(i)) std::this_thread::yield();
+		while (!t_Back.Pop(item)) std::this_thread::yield();
+		BenchCheck(item == i, "{} ping-pong got {} back instead of {}", t_Name, item, i);
+	}
+	const double ns = timer.Nanoseconds();
+	pong.join();
+
+	fmt::print("{:>6} {:>14.0f}\n", t_Name, ns / RoundTrips);
+}
+
+void QueuesBenchmark()
+{
+	fmt::print("{} items of uint64, ring of {}\n", ItemsCount, QueueCapacity);
+	fmt::print("{:>6} {:>10} {:>10} {:>12} {:>12}\n", "queue", "producers", "consumers", "ms", "Mitems/s");
+
+	SPSCQueue<uint64> spsc;
+	spsc.Init(QueueCapacity);
+	Throughput(spsc, "SPSC", 1, 1);
+
+	for (uint32 producers = 1; producers <= MaxSides; producers *= 2)
+	{
+		for (uint32 consumers = 1; consumers <= MaxSides; consumers *= 2)
+		{
+			MPMCQueue<uint64> mpmc;
+			mpmc.Init(QueueCapacity);
+			Throughput(mpmc, "MPMC", producers, consumers);
+		}
+	}
+
+	fmt::print("\n{:>6} {:>14}\n", "queue", "round trip ns");
+
+	SPSCQueue<uint64> spscThere, spscBack;
+	spscThere.Init(QueueCapacity);
+	spscBack.Init(QueueCapacity);
+	Latency(spscThere, spscBack, "SPSC");
+
+	MPMCQueue<uint64> mpmcThere, mpmcBack;
+	mpmcThere.Init(QueueCapacity);
+	mpmcBack.Init(QueueCapacity);
+	Latency(mpmcThere, mpmcBack, "MPMC");
+}
@@ -0,0 +1,91 @@
+#include "Benchmarks.hpp"
+
+#include <RadixSort.hpp>
+#include <Jobs.hpp>
+#include <Memory.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/*
+  @Note: RadixSort against std::sort from 1k to 1M items; once with random
+  keys over all of the 64 bits and once with sparse keys that leave most
+  of their bits empty like the sort keys of the renderer do. Every result
+  is checked against std::stable_sort. The parallel sort runs with a few
+  workers even on machines with fewer cores so that the jobs do run.
+*/
+
+static const uint32 RadixWorkers = 3;
+static const uint32 Repetitions = 5;
+
+static bool KeyLess(const SortItem& t_Left, const SortItem& t_Right)
+{
+	return t_Left.Key < t_Right.Key;
+}
+
+// @Note: The best of a few runs; every run sorts a fresh copy of the input
+template<class Sort>
+static double TimeSort(const std::vector<SortItem>& t_Input, std::vector<SortItem>& t_Output, Sort t_Sort)
+{
+	double best = 0.0;
+	for (uint32 i = 0; i < Repetitions; ++i)
+	{
+		t_Output = t_Input;
+		BenchTimer timer;
+		t_Sort(t_Output.data(), t_Output.size());
+		const double us = timer.Nanoseconds() / 1000.0;
+		best = i == 0 || us < best ? us : best;
+	}
+	return best;
+}
+
+static void RunSize(size_t t_Count, bool t_Sparse, std::mt19937_64& t_Random)
+{
+	std::vector<SortItem> input(t_Count);
+	for (size_t i = 0; i < t_Count; ++i)
+	{
+		const uint64 key = t_Random();
+		input[i] = { t_Sparse ? key & 0xFFFFFF : key, uint32(i) };
+	}
+
+	std::vector<SortItem> expected = input;
+	std::stable_sort(expected.begin(), expected.end(), KeyLess);
+
+	std::vector<SortItem> output;
+	const double stdTime = TimeSort(input, output, [](SortItem* t_Items, size_t t_Size) { std::sort(t_Items, t_Items + t_Size, KeyLess); });
+
+	const double radixTime = TimeSort(input, output, RadixSort::Sort);
+	for (size_t i = 0; i < t_Count; ++i)
+	{
+		BenchCheck(output[i].Key == expected[i].Key && output[i].Payload == expected[i].Payload, "RadixSort::Sort differs from std::stable_sort at {} of {}", i, t_Count);
+	}
+
+	const double parallelTime = TimeSort(input, output, RadixSort::SortParallel);
+	for (size_t i = 0; i < t_Count; ++i)
+	{
+		BenchCheck(output[i].Key == expected[i].Key && output[i].Payload == expected[i].Payload, "RadixSort::SortParallel differs from std::stable_sort at {} of {}", i, t_Count);
+	}
+
+	fmt::print("{:>8} {:>8} {:>12.1f} {:>12.1f} {:>12.1f}\n", t_Count, t_Sparse ? "sparse" : "random", stdTime, radixTime, parallelTime);
+}
+
+void RadixBenchmark()
+{
+	JobSystem::Init(RadixWorkers);
+	Memory::EstablishTempScope();
+
+	fmt::print("{} threads for the parallel sort, best of {} runs in us\n", JobSystem::ThreadsCount(), Repetitions);
+	fmt::print("{:>8} {:>8} {:>12} {:>12} {:>12}\n", "items", "keys", "std::sort", "radix", "parallel");
+
+	std::mt19937_64 random{42};
+	for (size_t count = 1000; count <= 1000000; count *= 10)
+	{
+		RunSize(count, false, random);
+		RunSize(count, true, random);
+	}
+
+	Memory::EndTempScope();
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,161 @@
+#include "Benchmarks.hpp"
+
+#include <Memory.hpp>
+#include <Containers.hpp>
+
+/*
+  @Note: The per-call cost of the two lists that moved to SmallVector,
+  against the temp scope and TempVector that they used before. DrawText
+  gathers the atlas entries of its glyphs; InsertAABB keeps the stack of
+  its traversal. Both are run once with sizes that fit inside of the
+  SmallVector and once with sizes that make it spill, and both versions
+  have to end up with the same result.
+*/
+
+static const uint32 Calls = 200000;
+static const uint32 CallsPerFrame = 1024;
+
+// @Note: The same layout as FontLibrary::AtlasEntry
+struct GlyphEntry
+{
+	float Pos[2];
+	float Size[2];
+	uint32 TexHandle;
+	float GlyphSize[2];
+	float Advance[2];
+};
+
+struct StackNode
+{
+	int Index;
+	float Inherited;
+};
+
+static GlyphEntry Glyphs[256];
+
+static float TextOld(const char* t_Text, size_t t_Size)
+{
+	Memory::EstablishTempScope();
+	TempVector<GlyphEntry> entries;
+	for (size_t i = 0; i < t_Size; ++i) entries.push_back(Glyphs[uint8(t_Text[i])]);
+
+	float pen = 0.0f;
+	for (const auto& entry : entries) pen += entry.Advance[0];
+	Memory::EndTempScope();
+	return pen;
+}
+
+static float TextNew(const char* t_Text, size_t t_Size)
+{
+	SmallVector<GlyphEntry, 64, FrameStdAllocator<GlyphEntry>> entries;
+	entries.resize(t_Size);
+	for (size_t i = 0; i < t_Size; ++i) entries[i] = Glyphs[uint8(t_Text[i])];
+
+	float pen = 0.0f;
+	for (const auto& entry : entries) pen += entry.Advance[0];
+	return pen;
+}
+
+// @Note: Walks a tree like the search for the best sibling does; every
+// inner node pushes both of its children. The balanced tree is full down
+// to the depth, the unbalanced one is a chain with a leaf on every level
+// so its stack grows as deep as the chain is long
+template<class Stack>
+static float Walk(Stack& t_Stack, int t_Depth, bool t_Balanced)
+{
+	float cost = 0.0f;
+	t_Stack.push_back({ 1, 0.0f });
+	while (!t_Stack.empty())
+	{
+		const StackNode node = t_Stack.back();
+		t_Stack.pop_back();
+		cost += node.Inherited;
+
+		if (node.Index < 0) continue;
+		if (t_Balanced && node.Index < (1 << t_Depth))
+		{
+			t_Stack.push_back({ node.Index * 2, node.Inherited + 1.0f });
+			t_Stack.push_back({ node.Index * 2 + 1, node.Inherited + 0.5f });
+		}
+		if (!t_Balanced && node.Index < t_Depth)
+		{
+			t_Stack.push_back({ -1, node.Inherited + 0.5f });
+			t_Stack.push_back({ node.Index + 1, node.Inherited + 1.0f });
+		}
+	}
+	return cost;
+}
+
+static float StackOld(int t_Depth, bool t_Balanced)
+{
+	Memory::EstablishTempScope();
+	TempVector<StackNode> stack;
+	stack.reserve(2048);
+	const float cost = Walk(stack, t_Depth, t_Balanced);
+	Memory::EndTempScope();
+	return cost;
+}
+
+// @Note: InsertAABB still opens a scope for the stacks that spill
+static float StackNew(int t_Depth, bool t_Balanced)
+{
+	Memory::EstablishTempScope();
+	float cost;
+	{
+		SmallVector<StackNode, 64> stack;
+		cost = Walk(stack, t_Depth, t_Balanced);
+	}
+	Memory::EndTempScope();
+	return cost;
+}
+
+template<class Call>
+static double TimeCalls(Call t_Call, uint32 t_Calls, float& t_Result)
+{
+	BenchTimer timer;
+	for (uint32 i = 0; i < t_Calls; ++i)
+	{
+		t_Result = t_Call();
+		DoNotOptimize(t_Result);
+		if ((i + 1) % CallsPerFrame == 0) Memory::FlipFrameMemory();
+	}
+	return timer.Nanoseconds() / t_Calls;
+}
+
+static void CompareText(const char* t_Name, size_t t_Size)
+{
+	char text[512];
+	for (size_t i = 0; i < t_Size; ++i) text[i] = char('A' + i % 58);
+
+	float oldPen, newPen;
+	const double oldTime = TimeCalls([&]() { return TextOld(text, t_Size); }, Calls, oldPen);
+	const double newTime = TimeCalls([&]() { return TextNew(text, t_Size); }, Calls, newPen);
+	BenchCheck(oldPen == newPen, "The {} text entries differ: {} and {}", t_Name, oldPen, newPen);
+
+	fmt::print("{:>24} {:>12.1f} {:>12.1f}\n", t_Name, oldTime, newTime);
+}
+
+static void CompareStack(const char* t_Name, int t_Depth, bool t_Balanced)
+{
+	float oldCost, newCost;
+	const double oldTime = TimeCalls([&]() { return StackOld(t_Depth, t_Balanced); }, Calls, oldCost);
+	const double newTime = TimeCalls([&]() { return StackNew(t_Depth, t_Balanced); }, Calls, newCost);
+	BenchCheck(oldCost == newCost, "The {} traversals differ: {} and {}", t_Name, oldCost, newCost);
+
+	fmt::print("{:>24} {:>12.1f} {:>12.1f}\n", t_Name, oldTime, newTime);
+}
+
+void SmallVectorBenchmark()
+{
+	for (uint32 i = 0; i < 256; ++i)
+	{
+		Glyphs[i] = { { float(i), 0.0f }, { 0.1f, 0.1f }, i, { 8.0f, 12.0f }, { float(i % 7) + 4.0f, 0.0f } };
+	}
+
+	fmt::print("ns per call, temp scope and TempVector against SmallVector\n");
+	fmt::print("{:>24} {:>12} {:>12}\n", "list", "TempVector", "SmallVector");
+	CompareText("text of 32 glyphs", 32);
+	CompareText("text of 300 glyphs", 300);
+	CompareStack("balanced tree of depth 4", 4, true);
+	CompareStack("chain of depth 100", 100, false);
+}
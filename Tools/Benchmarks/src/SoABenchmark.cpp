@@ -0,0 +1,121 @@
+#include "Benchmarks.hpp"
+
+#include <SoAVector.hpp>
+#include <Memory.hpp>
+
+#include <immintrin.h>
+
+/*
+  @Note: The update of the enemy positions from the SpaceGame over 100k
+  records; once with the whole entity as one struct and once with the
+  entity fields in the columns of a SoAVector. The SoA loop is run both
+  as plain scalar code and with SSE over the aligned columns.
+*/
+
+static const size_t RecordsCount = 100000;
+static const uint32 Iterations = 200;
+static const float DeltaTime = 1.0f / 60.0f;
+
+struct EnemyRecord
+{
+	float X;
+	float Y;
+	float XVelocity;
+	float YVelocity;
+	float Health;
+	uint32 Type;
+	uint32 Sprite;
+	float Timer;
+};
+
+using EnemyColumns = SoAVector<float, float, float, float, float, uint32, uint32, float>;
+
+static void UpdateAoS(BulkVector<EnemyRecord>& t_Enemies)
+{
+	for (auto& enemy : t_Enemies)
+	{
+		enemy.X += enemy.XVelocity * DeltaTime;
+		enemy.Y += enemy.YVelocity * DeltaTime;
+	}
+}
+
+static void UpdateSoAScalar(EnemyColumns& t_Enemies)
+{
+	auto x = t_Enemies.column<0>();
+	auto y = t_Enemies.column<1>();
+	auto xVelocity = t_Enemies.column<2>();
+	auto yVelocity = t_Enemies.column<3>();
+	for (size_t i = 0; i < t_Enemies.size(); ++i)
+	{
+		x[i] += xVelocity[i] * DeltaTime;
+		y[i] += yVelocity[i] * DeltaTime;
+	}
+}
+
+// @Note: The columns are padded to whole cache lines so the last step can
+// run over the garbage lanes after size()
+static void UpdateSoASimd(EnemyColumns& t_Enemies)
+{
+	float* x = t_Enemies.column<0>().data();
+	float* y = t_Enemies.column<1>().data();
+	const float* xVelocity = t_Enemies.column<2>().data();
+	const float* yVelocity = t_Enemies.column<3>().data();
+	const __m128 dt = _mm_set1_ps(DeltaTime);
+	for (size_t i = 0; i < t_Enemies.size(); i += 4)
+	{
+		_mm_store_ps(x + i, _mm_add_ps(_mm_load_ps(x + i), _mm_mul_ps(_mm_load_ps(xVelocity + i), dt)));
+		_mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(_mm_load_ps(yVelocity + i), dt)));
+	}
+}
+
+template<class Update, class Container>
+static double TimeUpdate(Update t_Update, Container& t_Enemies)
+{
+	t_Update(t_Enemies);
+
+	BenchTimer timer;
+	for (uint32 i = 0; i < Iterations; ++i)
+	{
+		t_Update(t_Enemies);
+		DoNotOptimize(t_Enemies);
+	}
+	return timer.Milliseconds() * 1000.0 / Iterations;
+}
+
+void SoABenchmark()
+{
+	BulkVector<EnemyRecord> aos;
+	aos.reserve(RecordsCount);
+
+	EnemyColumns scalar;
+	scalar.reserve(RecordsCount);
+
+	EnemyColumns simd;
+	simd.reserve(RecordsCount);
+
+	for (size_t i = 0; i < RecordsCount; ++i)
+	{
+		const float x = float(i % 640);
+		const float y = float(i / 640);
+		const float xVelocity = float(i % 7) - 3.0f;
+		const float yVelocity = float(i % 5) + 1.0f;
+		aos.push_back({ x, y, xVelocity, yVelocity, 100.0f, uint32(i % 3), 0, 0.0f });
+		scalar.push_back(x, y, xVelocity, yVelocity, 100.0f, uint32(i % 3), 0, 0.0f);
+		simd.push_back(x, y, xVelocity, yVelocity, 100.0f, uint32(i % 3), 0, 0.0f);
+	}
+
+	fmt::print("{} records, {} updates, us per update\n", RecordsCount, Iterations);
+	fmt::print("{:>12} {:>12} {:>12}\n", "AoS", "SoA scalar", "SoA SSE");
+
+	const double aosTime = TimeUpdate(UpdateAoS, aos);
+	const double scalarTime = TimeUpdate(UpdateSoAScalar, scalar);
+	const double simdTime = TimeUpdate(UpdateSoASimd, simd);
+	fmt::print("{:12.2f} {:12.2f} {:12.2f}\n", aosTime, scalarTime, simdTime);
+
+	// @Note: The three loops did the same updates in the same order
+	for (size_t i = 0; i < RecordsCount; ++i)
+	{
+		BenchCheck(aos[i].X == scalar.get<0>(i) && aos[i].Y == scalar.get<1>(i), "The AoS and SoA records differ at {}", i);
+		BenchCheck(simd.get<0>(i) == scalar.get<0>(i) && simd.get<1>(i) == scalar.get<1>(i), "The scalar and SSE records differ at {}", i);
+	}
+}
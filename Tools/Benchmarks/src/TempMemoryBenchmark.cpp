@@ -0,0 +1,65 @@
+#include "Benchmarks.hpp"
+
+#include <Memory.hpp>
+#include <Containers.hpp>
+
+#include <atomic>
+#include <thread>
+
+static const uint32 ScopesPerThread = 20000;
+
+// @Note: Nested scopes with a temp vector in the outer one and an
+// aligned block in the inner one; both are checked after the inner scope
+// is gone so anything that another thread wrote into this region shows up
+static void HammerTempScopes(uint32 t_Thread, std::atomic<uint32>& t_Errors)
+{
+	Memory::InitThreadTempMemory();
+
+	for (uint32 i = 0; i < ScopesPerThread; ++i)
+	{
+		Memory::EstablishTempScope();
+
+		TempVector<uint32> values;
+		for (uint32 j = 0; j < 256; ++j) values.push_back(t_Thread << 24 | j);
+
+		Memory::EstablishTempScope();
+		auto* block = (uint32*)Memory::TempAlloc(1024 * sizeof(uint32), 64);
+		if (((uintptr_t)block & 63) != 0) t_Errors.fetch_add(1);
+		for (uint32 j = 0; j < 1024; ++j) block[j] = ~(t_Thread << 24 | j);
+		for (uint32 j = 0; j < 1024; ++j)
+		{
+			if (block[j] != ~(t_Thread << 24 | j)) t_Errors.fetch_add(1);
+		}
+		Memory::EndTempScope();
+
+		for (uint32 j = 0; j < 256; ++j)
+		{
+			if (values[j] != (t_Thread << 24 | j)) t_Errors.fetch_add(1);
+		}
+
+		Memory::EndTempScope();
+	}
+
+	Memory::ReleaseThreadTempMemory();
+}
+
+void TempMemoryBenchmark()
+{
+	fmt::print("{:>8} {:>12} {:>16}\n", "threads", "ms", "scopes/s/thread");
+
+	for (uint32 threads = 1; threads <= Memory::MaxTempThreads; threads *= 2)
+	{
+		std::atomic<uint32> errors{0};
+		std::thread workers[Memory::MaxTempThreads];
+
+		BenchTimer timer;
+		for (uint32 i = 0; i < threads; ++i) workers[i] = std::thread(HammerTempScopes, i, std::ref(errors));
+		for (uint32 i = 0; i < threads; ++i) workers[i].join();
+		const double ms = timer.Milliseconds();
+
+		fmt::print("{:>8} {:>12.2f} {:>16.0f}\n", threads, ms, ScopesPerThread / (ms / 1000.0));
+		BenchCheck(errors.load() == 0, "{} threads corrupted each other's temporary memory {} times", threads, errors.load());
+	}
+
+	BenchCheck(Memory::g_Memory.ThreadsTempSlots.load() == 0, "Some of the thread temporary slots were not given back");
+}
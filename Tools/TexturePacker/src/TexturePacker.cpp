@@ -5,6 +5,7 @@
 #include <string>
 #include <cstdint>
 #include <fstream>
+#include <cstring>
 #include <GraphicsCommon.hpp>
 #include <Types.hpp>
 #include <Utils.hpp>
@@ -47,19 +48,14 @@ static void ParseCommandLineArguments(int argc, char *argv[], TexturePacker::Com
 	}
 }
 
+// @Note: Every row of the image is a contiguous run of pixels in the atlas as well
 static void PutPixels(std::vector<unsigned char>& atlasBytes, stbrp_rect rect, unsigned char* data, size_t atlasSize)
 {
-
+	const size_t rowSize = (size_t)rect.w * 4;
 	for (size_t i = 0; i < rect.h; ++i)
 	{
-		for (size_t j = 0; j < rect.w; ++j)
-		{
-			atlasBytes[((i + rect.y) * atlasSize + (j + rect.x))*4 + 0] = data[(i*rect.w + j)*4 + 0];
-			atlasBytes[((i + rect.y) * atlasSize + (j + rect.x))*4 + 1] = data[(i*rect.w + j)*4 + 1];
-			atlasBytes[((i + rect.y) * atlasSize + (j + rect.x))*4 + 2] = data[(i*rect.w + j)*4 + 2];
-			atlasBytes[((i + rect.y) * atlasSize + (j + rect.x))*4 + 3] = data[(i*rect.w + j)*4 + 3];
-		}
-	}	
+		std::memcpy(&atlasBytes[((i + rect.y) * atlasSize + rect.x) * 4], &data[i * rowSize], rowSize);
+	}
 }
 
 TexturePackerOutput PackTextures(TexturePacker::CommandLineArguments arguments, ImageToPack* imagesToPack, size_t imagesCount)